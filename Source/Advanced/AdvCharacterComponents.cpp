@@ -0,0 +1,37 @@
+#include "AdvCharacterComponents.h"
+
+#include "AdvancedCharacter.h"
+
+static void NotifyAttachmentChanged(const USceneComponent* Parent, const USceneComponent* ChildComponent)
+{
+	// Our own components never change the ignore list
+	AAdvancedCharacter* Character = Cast<AAdvancedCharacter>(Parent->GetOwner());
+	if (Character && ChildComponent && ChildComponent->GetOwner() != Character)
+	{
+		Character->MarkIgnoreCharacterParamsDirty();
+	}
+}
+
+void UAdvCapsuleComponent::OnChildAttached(USceneComponent* ChildComponent)
+{
+	Super::OnChildAttached(ChildComponent);
+	NotifyAttachmentChanged(this, ChildComponent);
+}
+
+void UAdvCapsuleComponent::OnChildDetached(USceneComponent* ChildComponent)
+{
+	Super::OnChildDetached(ChildComponent);
+	NotifyAttachmentChanged(this, ChildComponent);
+}
+
+void UAdvSkeletalMeshComponent::OnChildAttached(USceneComponent* ChildComponent)
+{
+	Super::OnChildAttached(ChildComponent);
+	NotifyAttachmentChanged(this, ChildComponent);
+}
+
+void UAdvSkeletalMeshComponent::OnChildDetached(USceneComponent* ChildComponent)
+{
+	Super::OnChildDetached(ChildComponent);
+	NotifyAttachmentChanged(this, ChildComponent);
+}
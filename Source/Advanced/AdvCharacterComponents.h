@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "AdvCharacterComponents.generated.h"
+
+/// AAdvancedCharacter's capsule, tells the character when another actor is attached to or detached from it
+UCLASS(ClassGroup = (Movement))
+class ADVANCED_API UAdvCapsuleComponent : public UCapsuleComponent
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void OnChildAttached(USceneComponent* ChildComponent) override;
+	virtual void OnChildDetached(USceneComponent* ChildComponent) override;
+};
+
+/// AAdvancedCharacter's mesh, tells the character when another actor is attached to or detached from it, weapons and the like go on its sockets
+UCLASS(ClassGroup = (Movement))
+class ADVANCED_API UAdvSkeletalMeshComponent : public USkeletalMeshComponent
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void OnChildAttached(USceneComponent* ChildComponent) override;
+	virtual void OnChildDetached(USceneComponent* ChildComponent) override;
+};
@@ -3,27 +3,71 @@
 #include "MaterialHLSLTree.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/GameStateBase.h"
 #include "Net/UnrealNetwork.h"
-#include "DrawDebugHelpers.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "SignificanceManager.h"
+#include "AdvCorrectionTelemetry.h"
+#include "AdvDebugDraw.h"
+#include "AdvLedgeData.h"
+#include "AdvMoveRecording.h"
+#include "AdvMovementStats.h"
+#include "AdvParallelMovementSubsystem.h"
+#include "AdvTraversalBudgetSubsystem.h"
+#include "AdvTraversalSubsystem.h"
 
 #include "Engine/OverlapResult.h"
 
+DEFINE_LOG_CATEGORY(LogAdvMovement);
+
+DECLARE_CYCLE_STAT(TEXT("PhysSlide"), STAT_AdvPhysSlide, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("PhysWallRun"), STAT_AdvPhysWallRun, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("PhysClimb"), STAT_AdvPhysClimb, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("TryMantle"), STAT_AdvTryMantle, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("TryHang"), STAT_AdvTryHang, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("TryClimb"), STAT_AdvTryClimb, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("TryWallRun"), STAT_AdvTryWallRun, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("HandleCustomCrouch"), STAT_AdvHandleCustomCrouch, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("HandleCustomUnCrouch"), STAT_AdvHandleCustomUnCrouch, STATGROUP_AdvMovement);
+DECLARE_CYCLE_STAT(TEXT("PrefetchMoveQueries"), STAT_AdvPrefetchMoveQueries, STATGROUP_AdvMovement);
+
+// Scene queries per caller, see ADV_COUNT_QUERY
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Ground"), STAT_AdvLineTrace_Ground, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Mantle"), STAT_AdvLineTrace_Mantle, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Wall Run"), STAT_AdvLineTrace_WallRun, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Climb"), STAT_AdvLineTrace_Climb, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Probe"), STAT_AdvLineTrace_Probe, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Prefetch"), STAT_AdvLineTrace_Prefetch, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Traces: Prefetch Live"), STAT_AdvLineTrace_PrefetchLive, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlaps: Crouch"), STAT_AdvOverlap_Crouch, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlaps: Mantle"), STAT_AdvOverlap_Mantle, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlaps: Probe"), STAT_AdvOverlap_Probe, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sweeps: Hang"), STAT_AdvSweep_Hang, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sweeps: Prefetch"), STAT_AdvSweep_Prefetch, STATGROUP_AdvMovement);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Move State Mismatches"), STAT_AdvClientMoveStateMismatches, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Moves Combined"), STAT_AdvClientMovesCombined, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Moves Sent"), STAT_AdvClientMovesSent, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client ServerMove RPCs"), STAT_AdvClientServerMoveRPCs, STATGROUP_AdvMovement);
+
 // Helper Macros
-#if 1
-float MacroDuration = 2.f;
-#define SLOG(x) GEngine->AddOnScreenDebugMessage(-1, MacroDuration ? MacroDuration : -1.f, FColor::Yellow, x);
-#define POINT(x, c) DrawDebugPoint(GetWorld(), x, 10, c, !MacroDuration, MacroDuration);
-#define LINE(x1, x2, c) DrawDebugLine(GetWorld(), x1, x2, c, !MacroDuration, MacroDuration);
-#define CAPSULE(x, c) DrawDebugCapsule(GetWorld(), x, CapHH(), CapR(), FQuat::Identity, c, !MacroDuration, MacroDuration);
-#define BOX(center, rotation, halfExtent, color) DrawDebugBox(GetWorld(), center, halfExtent, rotation, color, !MacroDuration, MacroDuration);
-#define SPHERE(loc, radius, color) DrawDebugSphere(GetWorld(), loc, radius, 32, color, !MacroDuration, MacroDuration);
+// Draws are recorded into UAdvDebugDrawSubsystem and only when adv.Debug.<Feature> is enabled
+// Arguments (including any FString::Printf) are not evaluated otherwise
+#if ADV_ENABLE_DEBUG_DRAW
+#define ADV_DEBUG(Feature) if (UAdvDebugDrawSubsystem* DebugDraw = UAdvDebugDrawSubsystem::GetIfEnabled(GetWorld(), EAdvDebugFeature::Feature)) DebugDraw
+#define SLOG(Feature, x) { ADV_DEBUG(Feature)->AddMessage(x); }
+#define POINT(Feature, x, c) { ADV_DEBUG(Feature)->AddPoint(x, c); }
+#define LINE(Feature, x1, x2, c) { ADV_DEBUG(Feature)->AddLine(x1, x2, c); }
+#define CAPSULE(Feature, x, c) { ADV_DEBUG(Feature)->AddCapsule(x, CapHH(), CapR(), c); }
+#define BOX(Feature, center, rotation, halfExtent, color) { ADV_DEBUG(Feature)->AddBox(center, rotation, halfExtent, color); }
+#define SPHERE(Feature, loc, radius, color) { ADV_DEBUG(Feature)->AddSphere(loc, radius, color); }
 #else
-#define SLOG(x);
-#define POINT(x, c);
-#define LINE(x1, x2, c);
-#define CAPSULE(x, c);
-#define BOX(center, color, rotation, halfExtent);
-#define SPHERE(loc, radius, color);
+#define SLOG(Feature, x);
+#define POINT(Feature, x, c);
+#define LINE(Feature, x1, x2, c);
+#define CAPSULE(Feature, x, c);
+#define BOX(Feature, center, rotation, halfExtent, color);
+#define SPHERE(Feature, loc, radius, color);
 #endif
 
 #pragma region Character Movement Component
@@ -31,6 +75,10 @@ float MacroDuration = 2.f;
 UAdvCharacterMovementComponent::UAdvCharacterMovementComponent()
 {
 	NavAgentProps.bCanCrouch = true;
+	SetNetworkMoveDataContainer(AdvNetworkMoveDataContainer);
+	Safe_TraversalProbeMask = PROBE_All;
+	Safe_TraversalProbeAccumulator = 0.0f;
+	Safe_bTraversalProbeDue = true;
 }
 
 void UAdvCharacterMovementComponent::InitializeComponent()
@@ -38,6 +86,8 @@ void UAdvCharacterMovementComponent::InitializeComponent()
 	Super::InitializeComponent();
 
 	AdvancedCharacterOwner = Cast<AAdvancedCharacter>(GetOwner());
+	Profile = ResolveMovementProfile();
+	if (MontageSet) MontageSet->Preload();
 	if (USkeletalMeshComponent* MeshComp = AdvancedCharacterOwner->GetMesh())
 	{
 		if (UAnimInstance* AnimInstance = MeshComp->GetAnimInstance())
@@ -47,6 +97,82 @@ void UAdvCharacterMovementComponent::InitializeComponent()
 	}
 }
 
+void UAdvCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UAdvTraversalBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UAdvTraversalBudgetSubsystem>())
+	{
+		Budget->RegisterMovement(this);
+	}
+
+	// Possession can change, the subsystem skips player controlled characters every frame
+	UAdvParallelMovementSubsystem* ParallelMovement = GetWorld()->GetSubsystem<UAdvParallelMovementSubsystem>();
+	if (ParallelMovement && Setting_ParallelPrefetch && GetOwnerRole() == ROLE_Authority)
+	{
+		ParallelMovement->RegisterMovement(this);
+		bParallelPrefetchRegistered = true;
+	}
+
+	// Only simulated proxies are scaled back, the significance is updated from the local views by AAdvPlayerCameraManager
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager && GetOwnerRole() == ROLE_SimulatedProxy)
+	{
+		if (const USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh())
+		{
+			ProxyAnimTickOption = Mesh->VisibilityBasedAnimTickOption;
+		}
+
+		SignificanceManager->RegisterObject(this, TEXT("AdvCharacterProxy"),
+			[this](USignificanceManager::FManagedObjectInfo*, const FTransform& Viewpoint) { return GetProxySignificance(Viewpoint); },
+			USignificanceManager::EPostSignificanceType::Sequential,
+			[this](USignificanceManager::FManagedObjectInfo*, float, float Significance, bool)
+			{
+				SetProxyDetail(Significance >= 2.0f ? EAdvProxyDetail::Full : Significance >= 1.0f ? EAdvProxyDetail::Reduced : EAdvProxyDetail::Minimal);
+			});
+		bProxySignificanceRegistered = true;
+	}
+}
+
+void UAdvCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAdvTraversalBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UAdvTraversalBudgetSubsystem>())
+	{
+		Budget->UnregisterMovement(this);
+	}
+
+	if (bParallelPrefetchRegistered)
+	{
+		if (UAdvParallelMovementSubsystem* ParallelMovement = GetWorld()->GetSubsystem<UAdvParallelMovementSubsystem>())
+		{
+			ParallelMovement->UnregisterMovement(this);
+		}
+		bParallelPrefetchRegistered = false;
+	}
+
+	if (bProxySignificanceRegistered)
+	{
+		if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+		{
+			SignificanceManager->UnregisterObject(this);
+		}
+		bProxySignificanceRegistered = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAdvCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// Attachments only change on the game thread, this tick's queries ignore whatever is attached now
+	if (AdvancedCharacterOwner) AdvancedCharacterOwner->UpdateIgnoreCharacterParams();
+#if !UE_BUILD_SHIPPING
+	if (AdvancedCharacterOwner) AdvancedCharacterOwner->CheckDimensions();
+#endif
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
 FNetworkPredictionData_Client* UAdvCharacterMovementComponent::GetPredictionData_Client() const
 {
 	check(PawnOwner != nullptr)
@@ -67,8 +193,16 @@ void UAdvCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
 {
 	Super::UpdateFromCompressedFlags(Flags);
 
-	Safe_bWantsToSprint = (Flags & FSavedMove_Adv::FLAG_Sprint) != 0;
-	Safe_bWantsToDash = (Flags & FSavedMove_Adv::FLAG_Dash) != 0;
+	// Everything past jump and crouch comes with the move data, there is none for the legacy ServerMove RPCs
+	const FAdvNetworkMoveData* MoveData = static_cast<const FAdvNetworkMoveData*>(GetCurrentNetworkMoveData());
+	if (!MoveData) return;
+
+	Safe_bWantsToSprint = (MoveData->AdvFlags & FAdvNetworkMoveData::MOVEFLAG_Sprint) != 0;
+	Safe_bWantsToDash = (MoveData->AdvFlags & FAdvNetworkMoveData::MOVEFLAG_Dash) != 0;
+	Safe_bWantsToProne = (MoveData->AdvFlags & FAdvNetworkMoveData::MOVEFLAG_Prone) != 0;
+	AdvancedCharacterOwner->bPressedAdvancedJump = (MoveData->AdvFlags & FAdvNetworkMoveData::MOVEFLAG_AdvancedJump) != 0;
+
+	CheckClientMoveState(MoveData->AdvFlags);
 }
 
 // After all the movement has been updated
@@ -86,6 +220,10 @@ void UAdvCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const
 
 void UAdvCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 {
+	// Results from the probes submitted at the end of the last move
+	ConsumeTraversalProbes();
+	UpdateTraversalProbeSchedule(DeltaSeconds);
+
 	// -- SLIDE -- //
 	// We need to do this before the crouch update gets to happen that's why its in this function
 	// !bWantsToCrouch will be false on the second press while we compare this to the previous safe crouch
@@ -102,9 +240,9 @@ void UAdvCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float De
 	{
 		SetMovementMode(MOVE_Walking);
 	}
-	else if (IsFalling())
+	else if (IsFalling() && CanTryTraversal(PROBE_Climb))
 	{
-		if (TryClimb()) SLOG("Climbing now")
+		if (TryClimb()) SLOG(Hang, "Climbing now")
 	}
 	else if ((IsClimbing() || IsHanging()) && bWantsToCrouch)
 	{
@@ -121,18 +259,18 @@ void UAdvCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float De
 		{
 			PerformDash();
 			Safe_bWantsToDash = false;
-			Proxy_bDashStart = !Proxy_bDashStart;
+			if (IsServer()) PushProxyEvent(EAdvProxyEventType::Dash);
 		}
 		else
 		{
 			// The dash auth cooldown was too great was this player cheating???
-			UE_LOG(LogTemp, Warning, TEXT("Client tried to cheat"))
+			ADV_LOG_RATELIMITED(LogAdvMovement, Warning, 1.0, TEXT("%s tried to dash before the auth cooldown finished"), *GetNameSafe(CharacterOwner))
 		}
 	}
 
 	if (AdvancedCharacterOwner->bPressedAdvancedJump)
 	{
-		if (TryMantle())
+		if (CanTryTraversal(PROBE_Mantle) && TryMantle())
 		{
 			AdvancedCharacterOwner->StopJumping();
 		}
@@ -152,47 +290,36 @@ void UAdvCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float De
 	// Transition
 	if (Safe_bTransitionFinished)
 	{
-		SLOG("Transition finished")
-		UE_LOG(LogTemp, Warning, TEXT("FINISHED RM"))
-		if (TransitionName == "Mantle")
+		SLOG(Movement, "Transition finished")
+		ADV_LOG_RATELIMITED(LogAdvMovement, Verbose, 1.0, TEXT("Transition root motion finished"))
+		switch (Transition.Kind)
 		{
-			if (IsValid(TransitionQueuedMontage))
+		case EAdvTransitionKind::Mantle:
+		case EAdvTransitionKind::Swing:
+			if (IsValid(Transition.QueuedMontage))
 			{
 				SetMovementMode(MOVE_Flying);
-				CharacterOwner->PlayAnimMontage(TransitionQueuedMontage, TransitionQueuedMontageSpeed);
-				TransitionQueuedMontageSpeed = 0.0f;
-				TransitionQueuedMontage = nullptr;
+				CharacterOwner->PlayAnimMontage(Transition.QueuedMontage, Transition.QueuedMontageSpeed);
 			}
 			else
 			{
 				SetMovementMode(MOVE_Walking);
-			}	
-		}
-		else if (TransitionName == "Hang")
-		{
+			}
+			break;
+		case EAdvTransitionKind::Hang:
 			SetMovementMode(MOVE_Custom, CMOVE_Hang);
 			Velocity = FVector::ZeroVector;
-		}
-		else if (TransitionName == "Swing")
-		{
-			if (IsValid(TransitionQueuedMontage))
-			{
-				SetMovementMode(MOVE_Flying);
-				CharacterOwner->PlayAnimMontage(TransitionQueuedMontage, TransitionQueuedMontageSpeed);
-				TransitionQueuedMontageSpeed = 0.0f;
-				TransitionQueuedMontage = nullptr;			}
-			else
-			{
-				SetMovementMode(MOVE_Walking);
-			}
+			break;
+		default:
+			break;
 		}
 
-		TransitionName = "";
+		Transition = FAdvTransition();
 		Safe_bTransitionFinished = false;
 	}
 
 	// -- WALL RUN -- //
-	if (IsFalling())
+	if (IsFalling() && CanTryTraversal(PROBE_WallRun))
 	{
 		TryWallRun();
 	}
@@ -208,7 +335,7 @@ void UAdvCharacterMovementComponent::UpdateCharacterStateAfterMovement(float Del
 	// After mantle finished go back to Walking
 	if (!HasAnimRootMotion() && Safe_bHadAnimRootMotion && IsMovementMode(MOVE_Flying))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Ending Anim Root Motion"))
+		ADV_LOG_RATELIMITED(LogAdvMovement, Verbose, 1.0, TEXT("Ending anim root motion"))
 		SetMovementMode(MOVE_Walking);
 	}
 	// You can't check for ERootMontionSourceStatusFlags::Finished in UpdateCharacterStateBeforeMovement since RootMotion is cleaned up before that function is called
@@ -220,6 +347,8 @@ void UAdvCharacterMovementComponent::UpdateCharacterStateAfterMovement(float Del
 	}
 
 	Safe_bHadAnimRootMotion = HasAnimRootMotion();
+
+	SubmitTraversalProbes(DeltaSeconds);
 }
 
 void UAdvCharacterMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
@@ -252,24 +381,27 @@ void UAdvCharacterMovementComponent::OnMovementModeChanged(EMovementMode Previou
 	
 	if (IsCustomMovementMode(CMOVE_Slide)) EnterSlide(PreviousMovementMode, (ECustomMovementMode)PreviousMovementMode);
 
-	if (IsCustomMovementMode(CMOVE_Hang)) SLOG("Switched to hang")
+	if (IsCustomMovementMode(CMOVE_Hang)) SLOG(Hang, "Switched to hang")
 
 	if (MovementMode == MOVE_Walking) Safe_bCanClimbAgain = true;
 	
 	if (IsFalling())
 	{
 		bOrientRotationToMovement = true;
+		// Every traversal starts in the air, stream its montages in before the first one
+		if (MontageSet)
+		{
+			MontageSet->RequestGroup(EAdvMontageGroup::Mantle);
+			MontageSet->RequestGroup(EAdvMontageGroup::Hang);
+		}
 	}
 	
 	// Simulated proxies will get OnMovementModeChanged triggered because custom movement mode is a replicated variable
 	// So instead do your own calculations to avoid using unnecessary bandwidth
-	if (IsWallRunning() && GetOwnerRole() == ROLE_SimulatedProxy)
+	// Proxies that are not fully simulated catch up once they are again (see SetProxyDetail)
+	if (IsWallRunning() && GetOwnerRole() == ROLE_SimulatedProxy && ProxyDetail == EAdvProxyDetail::Full)
 	{
-		FVector Start = UpdatedComponent->GetComponentLocation();
-		FVector End = Start + UpdatedComponent->GetRightVector() * CapR() * 2;
-		auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-		FHitResult WallHit;
-		Safe_bWallRunIsRight = GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
+		UpdateProxyWallRunSide();
 	}
 
 	OnStateChangedDelegate.Broadcast();
@@ -287,6 +419,14 @@ bool UAdvCharacterMovementComponent::CanCrouchInCurrentState() const
 	return Super::CanCrouchInCurrentState() && IsMovingOnGround();
 }
 
+void UAdvCharacterMovementComponent::UnCrouch(bool bClientSimulation)
+{
+	// The slide keeps the capsule crouched without bWantsToCrouch, proxies still follow bIsCrouched
+	if (!bClientSimulation && IsCustomMovementMode(CMOVE_Slide)) return;
+
+	Super::UnCrouch(bClientSimulation);
+}
+
 float UAdvCharacterMovementComponent::GetMaxSpeed() const
 {
 	if (IsMovementMode(MOVE_Walking) && Safe_bWantsToSprint && !IsCrouching()) return Sprint_MaxSpeed;
@@ -296,13 +436,13 @@ float UAdvCharacterMovementComponent::GetMaxSpeed() const
 	switch (CustomMovementMode)
 	{
 	case CMOVE_Slide:
-		return Slide_MaxSpeed;
+		return Profile->Slide_MaxSpeed;
 	case CMOVE_WallRun:
-		return WallRun_MaxSpeed;
+		return Profile->WallRun_MaxSpeed;
 	case CMOVE_Hang:
 		return 0.0f;
 	case CMOVE_Climb:
-		return Climb_MaxSpeed;
+		return Profile->Climb_MaxSpeed;
 	default:
 		UE_LOG(LogTemp, Fatal, TEXT("Invalid Movement Mode"))
 		return -1.0f;
@@ -316,13 +456,13 @@ float UAdvCharacterMovementComponent::GetMaxBrakingDeceleration() const
 	switch (CustomMovementMode)
 	{
 	case CMOVE_Slide:
-		return Slide_MaxBrakingDeceleration;
+		return Profile->Slide_MaxBrakingDeceleration;
 	case CMOVE_WallRun:
 		return 0.0f;
 	case CMOVE_Hang:
 		return 0.0f;
 	case CMOVE_Climb:
-		return Climb_BrakingDeceleration;
+		return Profile->Climb_BrakingDeceleration;
 	default:
 		UE_LOG(LogTemp, Fatal, TEXT("Invalid Movement Mode"))
 		return -1.0f;
@@ -349,20 +489,21 @@ bool UAdvCharacterMovementComponent::DoJump(bool bReplayingMoves)
 			FVector Start = UpdatedComponent->GetComponentLocation();
 			FVector CastDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
 			FVector End = Safe_bWallRunIsRight ? Start + CastDelta : Start - CastDelta;
-			auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-			FHitResult WallHit;
-			GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
-			Velocity += WallHit.Normal * WallRun_JumpOffForce;
+			FVector WallNormal;
+			if (FindWallRunWall(Start, End, WallNormal))
+			{
+				Velocity += WallNormal * Profile->WallRun_JumpOffForce;
+			}
 		}
 		else if (bWasOnWall)
 		{
 			// Only play the montage if there was no de-sync
 			if (!bReplayingMoves)
 			{
-				CharacterOwner->PlayAnimMontage(Hang_WallJumpMontage);
+				CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::HangWallJump));
 			}
-			Velocity += FVector::UpVector * Hang_WallJumpForce * 0.5f;
-			Velocity += Acceleration.GetSafeNormal2D() * Hang_WallJumpForce * 0.5f;
+			Velocity += FVector::UpVector * Profile->Hang_WallJumpForce * 0.5f;
+			Velocity += Acceleration.GetSafeNormal2D() * Profile->Hang_WallJumpForce * 0.5f;
 		}
 		
 		return true;
@@ -378,6 +519,9 @@ UAdvCharacterMovementComponent::FSavedMove_Adv::FSavedMove_Adv()
 {
 	Saved_bWantsToSprint = 0;
 	Saved_bPrevWantsToCrouch = 0;
+	Saved_bIsCrouched = 0;
+	Saved_TraversalProbeMask = PROBE_All;
+	Saved_TraversalProbeAccumulator = 0.0f;
 }
 
 bool UAdvCharacterMovementComponent::FSavedMove_Adv::CanCombineWith(const FSavedMovePtr& newMove, ACharacter* InCharacter, float MaxDelta) const
@@ -394,6 +538,12 @@ bool UAdvCharacterMovementComponent::FSavedMove_Adv::CanCombineWith(const FSaved
 		return false;
 	}
 
+	// Not part of the compressed flags the engine compares
+	if (Saved_bPressedAdvanceJump != NewAdvMove->Saved_bPressedAdvanceJump || Saved_bWantsToProne != NewAdvMove->Saved_bWantsToProne)
+	{
+		return false;
+	}
+
 	if (Saved_bWallRunIsRight != NewAdvMove->Saved_bWallRunIsRight)
 	{
 		return false;
@@ -403,6 +553,20 @@ bool UAdvCharacterMovementComponent::FSavedMove_Adv::CanCombineWith(const FSaved
 	{
 		return false;
 	}
+
+	if (Saved_Transition.Kind != NewAdvMove->Saved_Transition.Kind || Saved_TransitionRMS_ID != NewAdvMove->Saved_TransitionRMS_ID)
+	{
+		return false;
+	}
+
+	// The engine refuses moves that change movement mode, so both moves are in the current one
+	const UAdvCharacterMovementComponent* CharacterMovement = Cast<UAdvCharacterMovementComponent>(InCharacter->GetCharacterMovement());
+	// Wall run and climb moves combine on the same wall side with the same input, which is checked above and by the engine
+	// Hang moves only combine while hanging still, input can start a climb or a wall jump
+	if (CharacterMovement->IsHanging() && (!Acceleration.IsZero() || !NewAdvMove->Acceleration.IsZero()))
+	{
+		return false;
+	}
 	
 	return FSavedMove_Character::CanCombineWith(newMove, InCharacter, MaxDelta);
 }
@@ -417,6 +581,9 @@ void UAdvCharacterMovementComponent::FSavedMove_Adv::Clear()
 	
 	Saved_bHadAnimRootMotion = 0;
 	Saved_bTransitionFinished = 0;
+	Saved_Transition = FAdvTransition();
+	Saved_TransitionRMS_ID = 0;
+	Saved_WallRunContact = FWallRunContact();
 	
 	Saved_bWantsToProne = 0;
 	Saved_bPrevWantsToCrouch = 0;
@@ -424,17 +591,9 @@ void UAdvCharacterMovementComponent::FSavedMove_Adv::Clear()
 	Saved_bWallRunIsRight = 0;
 
 	Saved_bCanClimbAgain = 0;
-}
-
-uint8 UAdvCharacterMovementComponent::FSavedMove_Adv::GetCompressedFlags() const
-{
-	uint8 Result = Super::GetCompressedFlags();
-
-	if (Saved_bWantsToSprint) Result |= FLAG_Sprint;
-	if (Saved_bWantsToDash) Result |= FLAG_Dash;
-	if (Saved_bPressedAdvanceJump) Result |= FLAG_JumpPressed;
-
-	return Result;
+	Saved_bIsCrouched = 0;
+	Saved_TraversalProbeMask = PROBE_All;
+	Saved_TraversalProbeAccumulator = 0.0f;
 }
 
 void UAdvCharacterMovementComponent::FSavedMove_Adv::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
@@ -452,8 +611,13 @@ void UAdvCharacterMovementComponent::FSavedMove_Adv::SetMoveFor(ACharacter* C, f
 	Saved_bPressedAdvanceJump = CharacterMovement->AdvancedCharacterOwner->bPressedAdvancedJump;
 	Saved_bHadAnimRootMotion = CharacterMovement->Safe_bHadAnimRootMotion;
 	Saved_bTransitionFinished = CharacterMovement->Safe_bTransitionFinished;
+	Saved_Transition = CharacterMovement->Transition;
+	Saved_TransitionRMS_ID = CharacterMovement->TransitionRMS_ID;
+	Saved_WallRunContact = CharacterMovement->WallRunContact;
 
 	Saved_bCanClimbAgain = CharacterMovement->Safe_bCanClimbAgain;
+	Saved_bIsCrouched = C->bIsCrouched;
+	Saved_TraversalProbeAccumulator = CharacterMovement->Safe_TraversalProbeAccumulator;
 }
 
 void UAdvCharacterMovementComponent::FSavedMove_Adv::PrepMoveFor(ACharacter* C)
@@ -471,12 +635,272 @@ void UAdvCharacterMovementComponent::FSavedMove_Adv::PrepMoveFor(ACharacter* C)
 	CharacterMovement->AdvancedCharacterOwner->bPressedAdvancedJump = Saved_bPressedAdvanceJump;
 	CharacterMovement->Safe_bHadAnimRootMotion = Saved_bHadAnimRootMotion;
 	CharacterMovement->Safe_bTransitionFinished = Saved_bTransitionFinished;
+	// The root motion source itself is restored by the engine, it only has to be found again
+	CharacterMovement->Transition = Saved_Transition;
+	CharacterMovement->TransitionRMS_ID = Saved_TransitionRMS_ID;
+	CharacterMovement->WallRunContact = Saved_WallRunContact;
 
 	CharacterMovement->Safe_bCanClimbAgain = Saved_bCanClimbAgain;
+	// Replays must gate the Try* functions exactly like the original move did, they don't consume probes
+	CharacterMovement->Safe_TraversalProbeMask = Saved_TraversalProbeMask;
+	CharacterMovement->Safe_TraversalProbeAccumulator = Saved_TraversalProbeAccumulator;
+
+	// Slide enter and exit replay from the capsule the move was simulated with
+	CharacterMovement->RestoreCrouchedCapsule(Saved_bIsCrouched);
+}
+
+void UAdvCharacterMovementComponent::FSavedMove_Adv::PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode)
+{
+	Super::PostUpdate(C, PostUpdateMode);
+
+	// The mask is consumed at the start of the move, SetMoveFor only sees the previous move's
+	if (PostUpdateMode == PostUpdate_Record)
+	{
+		const UAdvCharacterMovementComponent* CharacterMovement = Cast<UAdvCharacterMovementComponent>(C->GetCharacterMovement());
+		Saved_TraversalProbeMask = CharacterMovement->Safe_TraversalProbeMask;
+	}
+}
+
+void UAdvCharacterMovementComponent::FSavedMove_Adv::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+	INC_DWORD_STAT(STAT_AdvClientMovesCombined);
+
+	// The combined move is simulated again from the start of the old one, the server only sees that single move
+	UAdvCharacterMovementComponent* CharacterMovement = Cast<UAdvCharacterMovementComponent>(InCharacter->GetCharacterMovement());
+	CharacterMovement->Safe_TraversalProbeAccumulator = static_cast<const FSavedMove_Adv*>(OldMove)->Saved_TraversalProbeAccumulator;
+}
+
+uint32 UAdvCharacterMovementComponent::FSavedMove_Adv::GetAdvFlags() const
+{
+	uint32 Result = 0;
+	if (Saved_bWantsToSprint) Result |= FAdvNetworkMoveData::MOVEFLAG_Sprint;
+	if (Saved_bWantsToDash) Result |= FAdvNetworkMoveData::MOVEFLAG_Dash;
+	if (Saved_bPressedAdvanceJump) Result |= FAdvNetworkMoveData::MOVEFLAG_AdvancedJump;
+	if (Saved_bWantsToProne) Result |= FAdvNetworkMoveData::MOVEFLAG_Prone;
+
+	if (Saved_bPrevWantsToCrouch) Result |= FAdvNetworkMoveData::MOVEFLAG_PrevWantsToCrouch;
+	if (Saved_bWallRunIsRight) Result |= FAdvNetworkMoveData::MOVEFLAG_WallRunIsRight;
+	if (Saved_bCanClimbAgain) Result |= FAdvNetworkMoveData::MOVEFLAG_CanClimbAgain;
+	if (Saved_bHadAnimRootMotion) Result |= FAdvNetworkMoveData::MOVEFLAG_HadAnimRootMotion;
+	if (Saved_bTransitionFinished) Result |= FAdvNetworkMoveData::MOVEFLAG_TransitionFinished;
+	return Result;
 }
 
 #pragma endregion Save Move
 
+#pragma region Network Move Data
+
+void UAdvCharacterMovementComponent::FAdvNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	AdvFlags = static_cast<const FSavedMove_Adv&>(ClientMove).GetAdvFlags();
+}
+
+bool UAdvCharacterMovementComponent::FAdvNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	bool bOk = Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// The new move is always serialized first and in full, the moves sent with it are usually identical
+	// ServerMove is unreliable so the last move the server acknowledged can't be used as the base
+	if (MoveType != ENetworkMoveType::NewMove)
+	{
+		const FAdvNetworkMoveData* NewMove = static_cast<const FAdvNetworkMoveData*>(CharacterMovement.GetNetworkMoveDataContainer().GetNewMoveData());
+		bool bSameAsNewMove = Ar.IsSaving() && AdvFlags == NewMove->AdvFlags;
+		Ar.SerializeBits(&bSameAsNewMove, 1);
+		if (bSameAsNewMove)
+		{
+			AdvFlags = NewMove->AdvFlags;
+			bOk &= !Ar.IsError();
+			return bOk;
+		}
+	}
+
+	Ar.SerializeIntPacked(AdvFlags);
+	bOk &= !Ar.IsError();
+	return bOk;
+}
+
+UAdvCharacterMovementComponent::FAdvNetworkMoveDataContainer::FAdvNetworkMoveDataContainer()
+{
+	NewMoveData = &AdvMoveData[0];
+	PendingMoveData = &AdvMoveData[1];
+	OldMoveData = &AdvMoveData[2];
+}
+
+void UAdvCharacterMovementComponent::CheckClientMoveState(uint32 ClientFlags) const
+{
+	uint32 ServerFlags = 0;
+	if (Safe_bPrevWantsToCrouch) ServerFlags |= FAdvNetworkMoveData::MOVEFLAG_PrevWantsToCrouch;
+	if (Safe_bWallRunIsRight) ServerFlags |= FAdvNetworkMoveData::MOVEFLAG_WallRunIsRight;
+	if (Safe_bCanClimbAgain) ServerFlags |= FAdvNetworkMoveData::MOVEFLAG_CanClimbAgain;
+	if (Safe_bHadAnimRootMotion) ServerFlags |= FAdvNetworkMoveData::MOVEFLAG_HadAnimRootMotion;
+	if (Safe_bTransitionFinished) ServerFlags |= FAdvNetworkMoveData::MOVEFLAG_TransitionFinished;
+
+	// Expected to differ for a move or two around a correction, the server's state is always the one used
+	const uint32 Mismatch = (ClientFlags ^ ServerFlags) & FAdvNetworkMoveData::MOVEFLAG_State;
+	if (Mismatch)
+	{
+		INC_DWORD_STAT(STAT_AdvClientMoveStateMismatches);
+		ADV_LOG_RATELIMITED(LogAdvMovement, Verbose, 1.0, TEXT("%s client move state differs from the server (0x%03x)"), *GetNameSafe(CharacterOwner), Mismatch)
+	}
+}
+
+float UAdvCharacterMovementComponent::GetClientNetSendDeltaTime(const APlayerController* PC, const FNetworkPredictionData_Client_Character* ClientData, const FSavedMovePtr& NewMove) const
+{
+	const float DefaultDeltaTime = Super::GetClientNetSendDeltaTime(PC, ClientData, NewMove);
+	if (MovementMode != MOVE_Custom) return DefaultDeltaTime;
+
+	float ModeDeltaTime = 0.0f;
+	switch (CustomMovementMode)
+	{
+	case CMOVE_Slide:
+		ModeDeltaTime = Net_SlideSendDeltaTime;
+		break;
+	case CMOVE_WallRun:
+		ModeDeltaTime = Net_WallRunSendDeltaTime;
+		break;
+	case CMOVE_Hang:
+		ModeDeltaTime = Net_HangSendDeltaTime;
+		break;
+	case CMOVE_Climb:
+		ModeDeltaTime = Net_ClimbSendDeltaTime;
+		break;
+	default:
+		break;
+	}
+
+	// The engine's own throttling for slow connections and idle characters still applies
+	return FMath::Max(DefaultDeltaTime, ModeDeltaTime);
+}
+
+void UAdvCharacterMovementComponent::CallServerMovePacked(const FSavedMove_Character* NewMove, const FSavedMove_Character* PendingMove, const FSavedMove_Character* OldMove)
+{
+	INC_DWORD_STAT(STAT_AdvClientServerMoveRPCs);
+	INC_DWORD_STAT_BY(STAT_AdvClientMovesSent, 1 + (PendingMove ? 1 : 0) + (OldMove ? 1 : 0));
+
+	// The old move is a resend of one the server may already have
+	if (MoveRecording.IsValid())
+	{
+		if (PendingMove) RecordMove(*PendingMove);
+		RecordMove(*NewMove);
+	}
+
+	Super::CallServerMovePacked(NewMove, PendingMove, OldMove);
+}
+
+bool UAdvCharacterMovementComponent::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	const bool bError = Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+
+#if ADV_ENABLE_MOVEMENT_STATS
+	if (bError)
+	{
+		const float Distance = FVector::Dist(UpdatedComponent->GetComponentLocation(), ClientWorldLocation);
+		FAdvCorrectionTelemetry::Record(FAdvCorrectionTelemetry::ESide::Server, GetCorrectionCategory(), Distance, 0.0f, ClientMovementMode != PackNetworkMovementMode());
+	}
+#endif
+
+	return bError;
+}
+
+void UAdvCharacterMovementComponent::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, FVector ServerGravityDirection)
+{
+#if ADV_ENABLE_MOVEMENT_STATS
+	// Still the predicted state, the correction is applied after this
+	// NewLocation is relative to the base when bBaseRelativePosition is set
+	const FVector ServerLocation = bBaseRelativePosition && NewBase ? NewBase->GetComponentTransform().TransformPosition(NewLocation) : NewLocation;
+	const float Distance = FVector::Dist(UpdatedComponent->GetComponentLocation(), ServerLocation);
+	FAdvCorrectionTelemetry::Record(FAdvCorrectionTelemetry::ESide::Client, GetCorrectionCategory(), Distance, FVector::Dist(Velocity, NewVelocity), ServerMovementMode != PackNetworkMovementMode());
+#endif
+
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode, ServerGravityDirection);
+}
+
+EAdvCorrectionCategory UAdvCharacterMovementComponent::GetCorrectionCategory() const
+{
+	// Transitions run in MOVE_Flying so they are checked before the mode
+	if (Transition.Kind == EAdvTransitionKind::Mantle) return EAdvCorrectionCategory::Mantle;
+	if (GetWorld()->GetTimeSeconds() - DashStartTime < Dash_CooldownDuration) return EAdvCorrectionCategory::Dash;
+	if (MovementMode != MOVE_Custom) return EAdvCorrectionCategory::Default;
+
+	switch (CustomMovementMode)
+	{
+	case CMOVE_Slide:
+		return EAdvCorrectionCategory::Slide;
+	case CMOVE_WallRun:
+		return EAdvCorrectionCategory::WallRun;
+	case CMOVE_Hang:
+		return EAdvCorrectionCategory::Hang;
+	case CMOVE_Climb:
+		return EAdvCorrectionCategory::Climb;
+	default:
+		return EAdvCorrectionCategory::Default;
+	}
+}
+
+#pragma endregion Network Move Data
+
+#pragma region Move Recording
+
+void UAdvCharacterMovementComponent::StartMoveRecording()
+{
+	MoveRecording = MakeShared<FAdvMoveRecording>();
+	MoveRecording->MapName = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+	MoveRecording->CharacterClass = CharacterOwner->GetClass()->GetPathName();
+}
+
+TSharedPtr<FAdvMoveRecording> UAdvCharacterMovementComponent::StopMoveRecording()
+{
+	TSharedPtr<FAdvMoveRecording> Recording = MoveRecording;
+	MoveRecording.Reset();
+	return Recording;
+}
+
+void UAdvCharacterMovementComponent::RecordMove(const FSavedMove_Character& Move)
+{
+	if (MoveRecording->Moves.IsEmpty())
+	{
+		MoveRecording->StartLocation = Move.StartLocation;
+		MoveRecording->StartRotation = Move.StartRotation;
+		MoveRecording->StartVelocity = Move.StartVelocity;
+		MoveRecording->StartMovementMode = Move.StartPackedMovementMode;
+	}
+
+	FAdvRecordedMove& Recorded = MoveRecording->Moves.AddDefaulted_GetRef();
+	Recorded.TimeStamp = Move.TimeStamp;
+	Recorded.DeltaTime = Move.DeltaTime;
+	// Rounded like the FVector_NetQuantize10 FCharacterNetworkMoveData sends, the replay simulates what the server did
+	const FVector& Acceleration = Move.Acceleration;
+	Recorded.Acceleration = FVector3f(FVector(FMath::RoundToDouble(Acceleration.X * 10.0), FMath::RoundToDouble(Acceleration.Y * 10.0), FMath::RoundToDouble(Acceleration.Z * 10.0)) / 10.0);
+	Recorded.ControlRotation = FRotator3f(Move.SavedControlRotation);
+	Recorded.CompressedFlags = Move.GetCompressedFlags();
+	Recorded.AdvFlags = static_cast<const FSavedMove_Adv&>(Move).GetAdvFlags();
+	Recorded.EndLocation = Move.SavedLocation;
+	Recorded.EndVelocity = FVector3f(Move.SavedVelocity);
+	Recorded.EndMovementMode = Move.EndPackedMovementMode;
+}
+
+void UAdvCharacterMovementComponent::ReplayRecordedMove(const FAdvRecordedMove& Move)
+{
+	// What ServerMove_PerformMovement does around MoveAutonomous
+	const FRotator ControlRotation(Move.ControlRotation);
+	if (AController* Controller = CharacterOwner->GetController())
+	{
+		Controller->SetControlRotation(ControlRotation);
+	}
+	CharacterOwner->FaceRotation(ControlRotation, Move.DeltaTime);
+
+	FAdvNetworkMoveData MoveData;
+	MoveData.AdvFlags = Move.AdvFlags;
+	SetCurrentNetworkMoveData(&MoveData);
+	MoveAutonomous(Move.TimeStamp, Move.DeltaTime, Move.CompressedFlags, FVector(Move.Acceleration));
+	SetCurrentNetworkMoveData(nullptr);
+}
+
+#pragma endregion Move Recording
+
 #pragma region Network Prediction Data
 
 UAdvCharacterMovementComponent::FNetworkPredictionData_Client_Adv::FNetworkPredictionData_Client_Adv(const UCharacterMovementComponent& ClientMovement)
@@ -559,38 +983,107 @@ bool UAdvCharacterMovementComponent::IsServer() const
 	return CharacterOwner->HasAuthority();
 }
 
-float UAdvCharacterMovementComponent::CapR() const
+UAnimMontage* UAdvCharacterMovementComponent::GetMontage(EAdvMontage Montage) const
+{
+	return MontageSet ? MontageSet->GetMontage(Montage) : nullptr;
+}
+
+bool UAdvCharacterMovementComponent::IsGroundWithin(float Distance, EQueryScene Scene) const
+{
+	// The floor search of the last walking move already measured this
+	if (IsMovingOnGround() && CurrentFloor.IsWalkableFloor() && CapHH() + CurrentFloor.GetDistanceToFloor() <= Distance) return true;
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	if (GroundProbe.Frame != GFrameCounter || !GroundProbe.Location.Equals(Location, UE_KINDA_SMALL_NUMBER) || Distance > GroundProbe.TraceDistance)
+	{
+		TraceGroundProbe(Location, Distance, Scene);
+	}
+	else if (GroundProbe.bStaticOnly && Scene != EQueryScene::Static)
+	{
+		TraceGroundProbe(Location, GroundProbe.TraceDistance, EQueryScene::Live);
+	}
+	return GroundProbe.HitDistance <= Distance;
+}
+
+void UAdvCharacterMovementComponent::TraceGroundProbe(const FVector& Location, float Distance, EQueryScene Scene) const
+{
+	// Long enough for every caller so the rest of the move reuses it
+	const float TraceDistance = FMath::Max3(CapHH() * 2.5f, CapHH() + Profile->WallRun_MinHeight, Distance);
+	FHitResult Hit;
+	ADV_COUNT_QUERY(LineTrace, Ground)
+	LineTraceScene(Hit, Location, Location + FVector::DownVector * TraceDistance, Scene);
+	const float HitDistance = Hit.IsValidBlockingHit() ? Hit.Distance : BIG_NUMBER;
+
+	if (Scene == EQueryScene::Live)
+	{
+		// Completes the prefetched static part
+		GroundProbe.HitDistance = FMath::Min(GroundProbe.HitDistance, HitDistance);
+		GroundProbe.bStaticOnly = false;
+		return;
+	}
+	GroundProbe.Location = Location;
+	GroundProbe.Frame = GFrameCounter;
+	GroundProbe.TraceDistance = TraceDistance;
+	GroundProbe.HitDistance = HitDistance;
+	GroundProbe.bStaticOnly = Scene == EQueryScene::Static;
+}
+
+bool UAdvCharacterMovementComponent::LineTraceScene(FHitResult& OutHit, const FVector& Start, const FVector& End, EQueryScene Scene) const
 {
-	return CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	return GetWorld()->LineTraceSingleByProfile(OutHit, Start, End, "BlockAll", AdvancedCharacterOwner->GetIgnoreCharacterParams(GetSceneMobility(Scene)));
 }
 
-float UAdvCharacterMovementComponent::CapHH() const
+void UAdvCharacterMovementComponent::StartTransition(const FAdvTransition& NewTransition)
 {
-	return CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	Transition = NewTransition;
+
+	// RootMotionSource kind of like a tween to drive the capsule from start to target position
+	// Once the last transition finished nothing else holds on to it so it can be reset in place instead of allocating a new one
+	if (TransitionRMS.IsValid() && TransitionRMS.IsUnique())
+	{
+		*TransitionRMS = FRootMotionSource_MoveToForce();
+	}
+	else
+	{
+		TransitionRMS = MakeShared<FRootMotionSource_MoveToForce>();
+	}
+	// No accumulation
+	TransitionRMS->AccumulateMode = ERootMotionAccumulateMode::Override;
+	TransitionRMS->Duration = Transition.Duration;
+	TransitionRMS->StartLocation = UpdatedComponent->GetComponentLocation();
+	TransitionRMS->TargetLocation = Transition.TargetLocation;
+
+	// Zero out the Velocity
+	Velocity = FVector::ZeroVector;
+	// Remove gravity application
+	SetMovementMode(MOVE_Flying);
+	TransitionRMS_ID = ApplyRootMotionSource(TransitionRMS);
 }
 
 void UAdvCharacterMovementComponent::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
-	if (LastMontage == "NA") return;
-	
+	if (!LastMantleClass.IsSet()) return;
+
+	const EAdvLedgeClass MantleClass = LastMantleClass.GetValue();
+	const bool bWasVault = MantleClass == EAdvLedgeClass::ShortVault || MantleClass == EAdvLedgeClass::TallVault;
 	if (bInterrupted)
 	{
-		if (LastMontage == "Vault" && bShouldVaultHang)
+		if (bWasVault && bShouldVaultHang)
 		{
-			SLOG("Here we would hang after a vault")
+			SLOG(Mantle, "Here we would hang after a vault")
 			bShouldVaultHang = false;
 		}
 	}
 	else
 	{
-		if (LastMontage == "Vault" && bShouldVaultHang)
+		if (bWasVault && bShouldVaultHang)
 		{
-			SLOG("Here we would hang after a vault")
+			SLOG(Mantle, "Here we would hang after a vault")
 			bShouldVaultHang = false;
 		}
 	}
 
-	LastMontage = "NA";
+	LastMantleClass.Reset();
 }
 
 #pragma endregion Helpers
@@ -601,7 +1094,7 @@ void UAdvCharacterMovementComponent::EnterSlide(EMovementMode PrevMode, ECustomM
 {
 	HandleCustomCrouch();
 	bOrientRotationToMovement = false;
-	//Velocity += Velocity.GetSafeNormal2D() * Slide_EnterImpulse; // Check last move and maybe we can add a velocity boost or a boost based on current velocity
+	//Velocity += Velocity.GetSafeNormal2D() * Profile->Slide_EnterImpulse; // Check last move and maybe we can add a velocity boost or a boost based on current velocity
 
 	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, true, nullptr);
 }
@@ -611,20 +1104,22 @@ void UAdvCharacterMovementComponent::ExitSlide()
 {
 	HandleCustomUnCrouch();
 	bOrientRotationToMovement = true;
-	SLOG("ExitSlide")
+	SLOG(Slide, "ExitSlide")
 }
 
 void UAdvCharacterMovementComponent::ExitSlideMode()
 {
-	SLOG("ExitSlideMode")
+	SLOG(Slide, "ExitSlideMode")
 	HandleCustomUnCrouch();
 	SetMovementMode(MOVE_Walking);
 }
 
-/// @todo make this network safe then replace native crouch mechanics
 void UAdvCharacterMovementComponent::HandleCustomCrouch()
 {
-	if (!HasValidData())
+	ADV_SCOPE_CYCLE_COUNTER(HandleCustomCrouch)
+
+	// Proxies crouch from the replicated bIsCrouched
+	if (!HasValidData() || CharacterOwner->bIsCrouched || CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
 	{
 		return;
 	}
@@ -640,11 +1135,13 @@ void UAdvCharacterMovementComponent::HandleCustomCrouch()
 	float ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
 	
 	// Crouching to a larger height? (this is rare)
-	if (ClampedCrouchedHalfHeight > OldUnscaledHalfHeight)
+	// Replayed moves already fitted when they were first simulated
+	if (ClampedCrouchedHalfHeight > OldUnscaledHalfHeight && !CharacterOwner->bClientUpdating)
 	{
 		FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(CrouchTrace), false, CharacterOwner);
 		FCollisionResponseParams ResponseParam;
 		InitCollisionParams(CapsuleParams, ResponseParam);
+		ADV_COUNT_QUERY(Overlap, Crouch)
 		const bool bEncroached = GetWorld()->OverlapBlockingTestByChannel(UpdatedComponent->GetComponentLocation() + ScaledHalfHeightAdjust * GetGravityDirection(), GetWorldToGravityTransform(),
 			UpdatedComponent->GetCollisionObjectType(), GetPawnCapsuleCollisionShape(SHRINK_None), CapsuleParams, ResponseParam);
 
@@ -662,27 +1159,29 @@ void UAdvCharacterMovementComponent::HandleCustomCrouch()
 	bForceNextFloorCheck = true;
 
 	// OnStartCrouch takes the change from the Default size, not the current one (though they are usually the same).
-	ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
-	HalfHeightAdjust = (DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() - ClampedCrouchedHalfHeight);
+	HalfHeightAdjust = (AdvancedCharacterOwner->GetDimensions().StandingHalfHeight - ClampedCrouchedHalfHeight);
 	ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
 
+	SetCharacterCrouched(true);
 	CharacterOwner->OnStartCrouch( HalfHeightAdjust, ScaledHalfHeightAdjust );
 }
 
 void UAdvCharacterMovementComponent::HandleCustomUnCrouch()
 {
-	if (!HasValidData())
+	ADV_SCOPE_CYCLE_COUNTER(HandleCustomUnCrouch)
+
+	if (!HasValidData() || !CharacterOwner->bIsCrouched || CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
 	{
 		return;
 	}
 
-	ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
+	const FAdvCharacterDimensions& Dimensions = AdvancedCharacterOwner->GetDimensions();
 
-	const float CurrentCrouchedHalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const float CurrentCrouchedHalfHeight = Dimensions.HalfHeight;
 
 	const float ComponentScale = CharacterOwner->GetCapsuleComponent()->GetShapeScale();
 	const float OldUnscaledHalfHeight = CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
-	const float HalfHeightAdjust = DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() - OldUnscaledHalfHeight;
+	const float HalfHeightAdjust = Dimensions.StandingHalfHeight - OldUnscaledHalfHeight;
 	const float ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
 	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
 
@@ -703,7 +1202,16 @@ void UAdvCharacterMovementComponent::HandleCustomUnCrouch()
 	
 	// Expand while keeping base location the same.
 	FVector StandingLocation = PawnLocation + (StandingCapsuleShape.GetCapsuleHalfHeight() - CurrentCrouchedHalfHeight) * -GetGravityDirection();
-	bEncroached = MyWorld->OverlapBlockingTestByChannel(StandingLocation, GetWorldToGravityTransform(), CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+	// Replayed moves trust the original simulation, a move that failed to stand up stays crouched in the saved move after it
+	if (CharacterOwner->bClientUpdating)
+	{
+		bEncroached = false;
+	}
+	else
+	{
+		ADV_COUNT_QUERY(Overlap, Crouch)
+		bEncroached = MyWorld->OverlapBlockingTestByChannel(StandingLocation, GetWorldToGravityTransform(), CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+	}
 
 	if (bEncroached)
 	{
@@ -714,6 +1222,7 @@ void UAdvCharacterMovementComponent::HandleCustomUnCrouch()
 			if (CurrentFloor.bBlockingHit && CurrentFloor.FloorDist > MinFloorDist)
 			{
 				StandingLocation -= (CurrentFloor.FloorDist - MinFloorDist) * -GetGravityDirection();
+				ADV_COUNT_QUERY(Overlap, Crouch)
 				bEncroached = MyWorld->OverlapBlockingTestByChannel(StandingLocation, GetWorldToGravityTransform(), CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
 			}
 		}				
@@ -726,52 +1235,83 @@ void UAdvCharacterMovementComponent::HandleCustomUnCrouch()
 		bForceNextFloorCheck = true;
 	}
 
-	// If still encroached then abort.
+	// If still encroached then abort, bIsCrouched stays set so the native UnCrouch retries once the slide is over
 	if (bEncroached)
 	{
 		return;
 	}
 	
 	// Now call SetCapsuleSize() to cause touch/untouch events and actually grow the capsule
-	CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleRadius(), DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight(), true);
+	CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(Dimensions.StandingRadius, Dimensions.StandingHalfHeight, true);
+	SetCharacterCrouched(false);
 	CharacterOwner->OnEndCrouch( HalfHeightAdjust, ScaledHalfHeightAdjust );
 }
 
-bool UAdvCharacterMovementComponent::CanEnterSlide() const
-{
-	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector End = Start + CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.5f * FVector::DownVector;
-	FName ProfileName = TEXT("BlockAll");
-	bool bValidSurface = GetWorld()->LineTraceTestByProfile(Start, End, ProfileName, AdvancedCharacterOwner->GetIgnoreCharacterParams());
-	bool bEnoughSpeed = Velocity.SizeSquared() > pow(Slide_MinEnterSpeed, 2);
-	
-	return bValidSurface && bEnoughSpeed;
-}
-
-bool UAdvCharacterMovementComponent::ShouldExitSlide() const
+void UAdvCharacterMovementComponent::SetCharacterCrouched(bool bCrouched)
 {
-	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector End = Start + CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.5f * FVector::DownVector;
-	FName ProfileName = TEXT("BlockAll");
-	bool bValidSurface = GetWorld()->LineTraceTestByProfile(Start, End, ProfileName, AdvancedCharacterOwner->GetIgnoreCharacterParams());
-	bool bEnoughSpeed = Velocity.SizeSquared() < pow(Slide_MinExitSpeed, 2);
-	
-	return (bValidSurface && bEnoughSpeed) || !UnSafe_bWantsToSlide;
+	// Replicated by ACharacter, proxies run Crouch/UnCrouch(true) from OnRep_IsCrouched
+	CharacterOwner->bIsCrouched = bCrouched;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ACharacter, bIsCrouched, CharacterOwner);
 }
 
-void UAdvCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations)
+void UAdvCharacterMovementComponent::RestoreCrouchedCapsule(bool bCrouched)
 {
-	// Source code boilerplate stuff
-	if (deltaTime < MIN_TICK_TIME)
+	if (!HasValidData() || CharacterOwner->bIsCrouched == bCrouched)
 	{
 		return;
 	}
 
-	if (ShouldExitSlide())
+	// The corrected location is already the center of the capsule the server had, so only the size changes
+	const FAdvCharacterDimensions& Dimensions = AdvancedCharacterOwner->GetDimensions();
+	const float ClampedCrouchedHalfHeight = FMath::Max3(0.f, Dimensions.StandingRadius, CrouchedHalfHeight);
+	const float HalfHeightAdjust = Dimensions.StandingHalfHeight - ClampedCrouchedHalfHeight;
+	const float ScaledHalfHeightAdjust = HalfHeightAdjust * Dimensions.Scale;
+
+	CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(Dimensions.StandingRadius, bCrouched ? ClampedCrouchedHalfHeight : Dimensions.StandingHalfHeight);
+	SetCharacterCrouched(bCrouched);
+	bForceNextFloorCheck = true;
+
+	if (bCrouched)
 	{
-		SetMovementMode(MOVE_Walking);
-		StartNewPhysics(deltaTime, Iterations);
-		return;
+		CharacterOwner->OnStartCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
+	}
+	else
+	{
+		CharacterOwner->OnEndCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
+	}
+}
+
+bool UAdvCharacterMovementComponent::CanEnterSlide() const
+{
+	// Speed first, the ground check is only needed when it passes
+	bool bEnoughSpeed = Velocity.SizeSquared() > Profile->Slide_MinEnterSpeedSquared;
+	
+	return bEnoughSpeed && IsGroundWithin(CapHH() * 2.5f);
+}
+
+bool UAdvCharacterMovementComponent::ShouldExitSlide() const
+{
+	if (!UnSafe_bWantsToSlide) return true;
+	bool bEnoughSpeed = Velocity.SizeSquared() < Profile->Slide_MinExitSpeedSquared;
+	
+	return bEnoughSpeed && IsGroundWithin(CapHH() * 2.5f);
+}
+
+void UAdvCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations)
+{
+	ADV_SCOPE_CYCLE_COUNTER(PhysSlide)
+
+	// Source code boilerplate stuff
+	if (deltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	if (ShouldExitSlide())
+	{
+		SetMovementMode(MOVE_Walking);
+		StartNewPhysics(deltaTime, Iterations);
+		return;
 	}
 
 	bJustTeleported = false;
@@ -800,7 +1340,7 @@ void UAdvCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations
 		// Calculate a slope force for going down slopes
 		FVector SlopeForce = CurrentFloor.HitResult.Normal;
 		SlopeForce.Z = 0.0f;
-		Velocity += SlopeForce * Slide_GravityForce * deltaTime;
+		Velocity += SlopeForce * Profile->Slide_GravityForce * deltaTime;
 
 		Acceleration = Acceleration.ProjectOnTo(UpdatedComponent->GetRightVector().GetSafeNormal2D());
 
@@ -808,7 +1348,7 @@ void UAdvCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations
 		float NormalizedSpeed = FMath::Clamp(CurrentSpeed / GetMaxSpeed(), 0.0f, 1.0f);
 		
 		// bFluid -> friction is applied more instead apply your own Slide_FrictionFactor
-		CalcVelocity(timeTick, GroundFriction * Slide_FrictionCurveFactor->GetFloatValue(NormalizedSpeed), false, GetMaxBrakingDeceleration());
+		CalcVelocity(timeTick, GroundFriction * Profile->Slide_FrictionSamples->Evaluate(NormalizedSpeed), false, GetMaxBrakingDeceleration());
 
 		// Move parameters
 		const FVector MoveVelocity = Velocity;
@@ -877,7 +1417,7 @@ void UAdvCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations
 					HandleWalkingOffLedge(OldFloor.HitResult.ImpactNormal, OldFloor.HitResult.Normal, OldLocation, timeTick);
 					if (IsMovingOnGround())
 					{
-						SLOG("Start Falling Here")
+						SLOG(Slide, "Start Falling Here")
 						// If still walking, then fall. If not assume the user set a different mode they want to keep.
 						StartFalling(Iterations, remainingTime, timeTick, Delta, OldLocation);
 					}
@@ -962,7 +1502,7 @@ void UAdvCharacterMovementComponent::PerformDash()
 	if (Setting_GravityEnabledDash) SetMovementMode(MOVE_Falling);
 	else SetMovementMode(MOVE_Flying);
 	
-	CharacterOwner->PlayAnimMontage(Dash_Montage);
+	CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::Dash));
 	DashStartDelegate.Broadcast();
 }
 
@@ -972,55 +1512,154 @@ void UAdvCharacterMovementComponent::PerformDash()
 
 bool UAdvCharacterMovementComponent::TryMantle()
 {
+	ADV_SCOPE_CYCLE_COUNTER(TryMantle)
+
 	// Conditions for allowing the Mantle
 	if (!(IsMovementMode(MOVE_Walking) && !IsCrouching()) && !IsMovementMode(MOVE_Falling) && !IsCustomMovementMode(CMOVE_Climb)) return false;
 
 	// Helper variables
+	FVector BaseLoc, Fwd;
+	float CheckDistance;
+	GetMantleProbe(BaseLoc, Fwd, CheckDistance);
+	const FCollisionQueryParams& Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
+	FCollisionShape CapShape = FCollisionShape::MakeCapsule(CapR(), CapHH());
 
-	// Get the bottom of the capsule
-	FVector BaseLoc = UpdatedComponent->GetComponentLocation() + FVector::DownVector * CapHH();
-	FVector Fwd = UpdatedComponent->GetForwardVector().GetSafeNormal2D();
-	auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-	float MaxHeight = Mantle_MaxClimbHeight; // Assuming this has the largest value
-	// Minimum steepness we are going to tolerate
-	float CosMMWSA = FMath::Cos(FMath::DegreesToRadians(Mantle_MinWallSteepnessAngle));
-	float CosMMSA = FMath::Cos(FMath::DegreesToRadians(Mantle_MaxSurfaceAngle));
-	// Max alignment of player to wall to mantle
-	float CosMMAA = FMath::Cos(FMath::DegreesToRadians(Mantle_MaxAlignmentAngle));
+	SLOG(Mantle, "Starting Mantle Attempt")
 
-	SLOG("Starting Mantle Attempt")
+	// ---- FIND LEDGE ---- //
+	// Baked ledges cover the static primitives. The live front traces run first since a baked ledge behind the nearest live hit can't be reached,
+	// once every loaded level has ledges baked for this character they are all that is left of the front traces
+	const UAdvTraversalSubsystem* Traversal = GetWorld()->GetSubsystem<UAdvTraversalSubsystem>();
+	const FAdvLedgeBakeKey BakeKey = GetLedgeBakeKey();
+	FHitResult FrontHit, SurfaceHit, LiveFrontHit;
+	float Height;
+	bool shouldVault;
+	bool bFoundLedge = false;
+	bool bLiveFrontTraced = false;
+	if (Traversal && Traversal->HasLedgeData(BakeKey))
+	{
+		TraceMantleFront(BaseLoc, Fwd, CheckDistance, EQueryScene::Live, MantleFrontTraces, LiveFrontHit);
+		bLiveFrontTraced = Traversal->HasCompleteLedgeData(BakeKey);
+		bFoundLedge = FindBakedMantleLedge(BakeKey, BaseLoc, Fwd, LiveFrontHit.bBlockingHit ? LiveFrontHit.Distance : CheckDistance, FrontHit, SurfaceHit, Height, shouldVault);
+	}
+	if (!bFoundLedge && !TraceMantleLedge(BaseLoc, Fwd, CheckDistance, bLiveFrontTraced ? &LiveFrontHit : nullptr, FrontHit, SurfaceHit, Height, shouldVault)) return false;
 
-	int numberOfLineTraces = 5;
+	const EAdvLedgeClass ShortClass = shouldVault ? EAdvLedgeClass::ShortVault : EAdvLedgeClass::ShortMantle;
+	const EAdvLedgeClass TallClass = shouldVault ? EAdvLedgeClass::TallVault : EAdvLedgeClass::TallMantle;
+	
+	FVector ShortMantleTarget = GetMantleStartLocation(FrontHit, SurfaceHit, ShortClass);
+	FVector TallMantleTarget = GetMantleStartLocation(FrontHit, SurfaceHit, TallClass);
+
+	bool bTallMantle = false;
+	// Check heights for either Mantle or Vault
+	if (IsMovementMode(MOVE_Walking) && Height > (shouldVault ? Profile->Mantle_MinTallVaultHeight : Profile->Mantle_MinTallClimbHeight))
+		bTallMantle = true;
+	// If we are falling and Velocity is downward
+	else if (IsMovementMode(MOVE_Falling) && (Velocity | FVector::UpVector) < 0)
+	{
+		// Don't want to tall mantle if the object is not tall enough for the tall mantle animation which is capsule height
+		ADV_COUNT_QUERY(Overlap, Mantle)
+		if (!GetWorld()->OverlapAnyTestByProfile(TallMantleTarget, FQuat::Identity, "BlockAll", CapShape, Params))
+			bTallMantle = true;
+	}
+
+	FVector TransitionTarget = bTallMantle ? TallMantleTarget : ShortMantleTarget;
+	CAPSULE(Mantle, TransitionTarget, FColor::Yellow)
+	// Perform Transition to Mantle
+	CAPSULE(Mantle, UpdatedComponent->GetComponentLocation(), FColor::Red)
+
+	// The transition montage speed is controlled by the current UpSpeed
+	// If the character was moving upward then we speed up the transition
+	// If the character was moving downward then we slow down the transtion
+	// Makes it feel more realistic
+	float UpSpeed = Velocity | FVector::UpVector;
+	float TransDistance = FVector::Dist(TransitionTarget, UpdatedComponent->GetComponentLocation());
+	FAdvTransition MantleTransition;
+	MantleTransition.Kind = EAdvTransitionKind::Mantle;
+	MantleTransition.HeightClass = bTallMantle ? TallClass : ShortClass;
+	MantleTransition.TargetLocation = TransitionTarget;
+	MantleTransition.TargetRotation = UpdatedComponent->GetComponentQuat();
+	// Duration of the transition based on how far you are away from the target distance
+	MantleTransition.Duration = FMath::Clamp(TransDistance / 500.0f, Profile->Mantle_MinTransitionTime, Profile->Mantle_MaxTransitionTime);
+	MantleTransition.QueuedMontageSpeed = FMath::GetMappedRangeValueClamped(FVector2D(-500, 750), FVector2D(0.9f, 1.2f), UpSpeed);
+	SLOG(Mantle, FString::Printf(TEXT("Duration: %f"), MantleTransition.Duration))
+	LastMantleClass = MantleTransition.HeightClass; // ID for OnMontageEnd
+
+	StartTransition(MantleTransition);
+
+	// Queue animations
+	// Transition Montages are NOT root animations
+	// Transition Montages are 1 second and the speed can be scaled based on the transition duration
+	SetMantleMontages(Transition.HeightClass);
+
+	if (Transition.HeightClass == EAdvLedgeClass::TallVault)
+	{
+		SLOG(Mantle, "THIS WAS MET")
+	}
+	
+	return true;
+}
+
+void UAdvCharacterMovementComponent::GetMantleProbe(FVector& OutBaseLoc, FVector& OutFwd, float& OutCheckDistance) const
+{
+	// Get the bottom of the capsule
+	OutBaseLoc = UpdatedComponent->GetComponentLocation() + FVector::DownVector * CapHH();
+	OutFwd = UpdatedComponent->GetForwardVector().GetSafeNormal2D();
 
-	// ---- FRONT TRACE ---- //
-	// Check the front face (Wall that is in front of you)
-	FHitResult FrontHit;
 	// We want a longer check distance if the character has velocity toward the forward vector (which is the direction we check the wall for)
 	// And a shorter check distance if the character velocity is in the opposite direction of the forward vector
 	// We clamp this check distance to CapR + 30 minimum and Mantle_MaxDistance maximum based on the Velocity | Fwd
-	float CheckDistance = FMath::Clamp(Velocity | Fwd, CapR() + 30, Mantle_MaxDistance);
-	// We want to mantle it if it is above the max step height so we start how checks from here up
-	FVector FrontStart = BaseLoc + FVector::UpVector * (Mantle_MinShortClimbHeight - 1);
-	for (int i = 0; i < numberOfLineTraces + 1; i++)
+	OutCheckDistance = FMath::Clamp(Velocity | OutFwd, CapR() + 30, Profile->Mantle_MaxDistance);
+}
+
+bool UAdvCharacterMovementComponent::TraceMantleLedge(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, const FHitResult* LiveFrontHit, FHitResult& FrontHit, FHitResult& SurfaceHit, float& Height, bool& bShouldVault)
+{
+	const FCollisionQueryParams& Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
+	float MaxHeight = Profile->Mantle_MaxClimbHeight; // Assuming this has the largest value
+	// Minimum steepness we are going to tolerate
+	float CosMMWSA = Profile->Mantle_CosMinWallSteepnessAngle;
+	float CosMMSA = Profile->Mantle_CosMaxSurfaceAngle;
+	// Max alignment of player to wall to mantle
+	float CosMMAA = Profile->Mantle_CosMaxAlignmentAngle;
+	FCollisionShape CapShape = FCollisionShape::MakeCapsule(CapR(), CapHH());
+	// May be left over from a rejected baked ledge
+	FrontHit = SurfaceHit = FHitResult();
+
+	// ---- FRONT TRACE ---- //
+	// Check the front face (Wall that is in front of you)
+	if (LiveFrontHit)
 	{
-		LINE(FrontStart, FrontStart + Fwd * CheckDistance, FColor::Red)
-		if (GetWorld()->LineTraceSingleByProfile(FrontHit, FrontStart, FrontStart + Fwd * CheckDistance, "BlockAll", Params)) break;
-		FrontStart += FVector::UpVector * (2.0f * CapHH() - (Mantle_MinShortClimbHeight - 1)) / numberOfLineTraces;
+		FrontHit = *LiveFrontHit;
+	}
+	else if (const FPrefetchedTrace* Prefetched = FindPrefetchedTrace(PREFETCH_MantleFront, BaseLoc, BaseLoc + Fwd * CheckDistance))
+	{
+		// Anything but static geometry may have moved in front of, or below, the prefetched hit since
+		FrontHit = Prefetched->Hit;
+		FHitResult LiveHit;
+		const int32 LiveIndex = TraceMantleFront(BaseLoc, Fwd, CheckDistance, EQueryScene::Live, Prefetched->HitIndex == INDEX_NONE ? MantleFrontTraces : Prefetched->HitIndex + 1, LiveHit);
+		if (LiveIndex != INDEX_NONE && (Prefetched->HitIndex == INDEX_NONE || LiveIndex < Prefetched->HitIndex || LiveHit.Distance < FrontHit.Distance)) FrontHit = LiveHit;
+	}
+	else
+	{
+		TraceMantleFront(BaseLoc, Fwd, CheckDistance, EQueryScene::All, MantleFrontTraces, FrontHit);
 	}
 	if (!FrontHit.IsValidBlockingHit()) return false;
+	LINE(Mantle, FrontHit.TraceStart, FrontHit.TraceEnd, FColor::Red)
 
-	if (FrontHit.GetActor()->ActorHasTag("Climb Point") || FrontHit.GetActor()->ActorHasTag("Swing Point")) return false;
+	if (const UAdvTraversalSubsystem* Traversal = GetWorld()->GetSubsystem<UAdvTraversalSubsystem>())
+	{
+		if (Traversal->IsGrabPoint(FrontHit.GetActor())) return false;
+	}
 	
 	// Get the steepness of the Normal of the hit
 	float CosWallSteepnessAngle = FrontHit.Normal | FVector::UpVector;
 	// First check is for the steepness of the wall the second check is for the angle of the wall to the player i.e. how close is your fwd to being perpendicular to the wall
 	// So we get the minus of the hit (so about the same direction as fwd)
 	if (FMath::Abs(CosWallSteepnessAngle) > CosMMWSA || (Fwd | -FrontHit.Normal) < CosMMAA) return false;
-	POINT(FrontHit.Location, FColor::Red);
+	POINT(Mantle, FrontHit.Location, FColor::Red);
 
 	// ---- TOP TRACE ---- //
 	TArray<FHitResult> HeightHits;
-	FHitResult SurfaceHit;
 	// The point in which we want to get to in order to mantle may not be directly up in the case in which the wall has some slant
 	// Therefor we must project the world up vector onto the surface normal and there we can follow it up to the top of this plane to get
 	// where we want to mantle onto (@ 51 minutes)
@@ -1029,10 +1668,11 @@ bool UAdvCharacterMovementComponent::TryMantle()
 	float WallSin = FMath::Sqrt(1 - WallCos * WallCos);
 	// Hit -> Move into the wall by 3 Fwd (So we can detect very thin starts NOT SUPER EFFECTIVE instead try move in by half distance? come back to this later) @todo
 	// -> Up the wall in the direction of WallUp till max height minus min height -> ?? WallSin ?? @todo
-	FVector TraceStart = FrontHit.Location + (Fwd * 3) + WallUp * (MaxHeight - (Mantle_MinShortClimbHeight - 1)) / WallSin;
-	LINE(TraceStart, FrontHit.Location + Fwd, FColor::Orange)
+	FVector TraceStart = FrontHit.Location + (Fwd * 3) + WallUp * (MaxHeight - (Profile->Mantle_MinShortClimbHeight - 1)) / WallSin;
+	LINE(Mantle, TraceStart, FrontHit.Location + Fwd, FColor::Orange)
 
 	// Get multiple collision points in case there is something above that mantle wall
+	ADV_COUNT_QUERY(LineTrace, Mantle)
 	if (!GetWorld()->LineTraceMultiByProfile(HeightHits, TraceStart, FrontHit.Location + Fwd, "BlockAll", Params)) return false;
 
 	for (const FHitResult Hit : HeightHits)
@@ -1048,10 +1688,10 @@ bool UAdvCharacterMovementComponent::TryMantle()
 	// Limit to the angle which can be mantled on
 	if (!SurfaceHit.IsValidBlockingHit() || (SurfaceHit.Normal | FVector::UpVector) < CosMMSA) return false;
 	// @todo review
-	float Height = (SurfaceHit.Location - BaseLoc) | FVector::UpVector;
+	Height = (SurfaceHit.Location - BaseLoc) | FVector::UpVector;
 
-	SLOG(FString::Printf(TEXT("Height: %f"), Height))
-	POINT(SurfaceHit.Location, FColor::Blue)
+	SLOG(Mantle, FString::Printf(TEXT("Height: %f"), Height))
+	POINT(Mantle, SurfaceHit.Location, FColor::Blue)
 
 	if (Height > MaxHeight) return false;
 
@@ -1063,172 +1703,187 @@ bool UAdvCharacterMovementComponent::TryMantle()
 	// Move the capsule by the Fwd of the Capsule radius so they are fully on the geometry
 	// Up vector multiplied by the height adding the height of the surface angle (Accounts for the height caused by the angle of the surface)
 	FVector ClearCapLoc = SurfaceHit.Location + Fwd * CapR() + FVector::UpVector * (CapHH() + 1 + CapR() * 2 * SurfaceSin);
-	FCollisionShape CapShape = FCollisionShape::MakeCapsule(CapR(), CapHH());
+	ADV_COUNT_QUERY(Overlap, Mantle)
 	if (GetWorld()->OverlapAnyTestByProfile(ClearCapLoc, FQuat::Identity, "BlockAll", CapShape, Params))
 	{
-		CAPSULE(ClearCapLoc, FColor::Red)
+		CAPSULE(Mantle, ClearCapLoc, FColor::Red)
 		return false;
 	}
 
-	CAPSULE(ClearCapLoc, FColor::Green)
-	SLOG("Can Mantle")
+	CAPSULE(Mantle, ClearCapLoc, FColor::Green)
+	SLOG(Mantle, "Can Mantle")
 
 	// ---- CHECK IF SHOULD VAULT ---- //
 	// Essentially walls that are less than 1 capsule thick and has enough room for a capsule on the other side
-	bool shouldVault = false;
+	bShouldVault = false;
 	FHitResult VaultHit;
 	FVector VaultStart = FrontHit.Location + -FrontHit.Normal * CapR() * 2;
 	VaultStart.Z = UpdatedComponent->GetComponentLocation().Z - CapHH() * 0.5;
 	FVector VaultEnd = VaultStart + FVector::DownVector * CapHH() * 2.5;
 	
-	LINE(VaultStart, VaultEnd, FColor::Purple)
+	LINE(Mantle, VaultStart, VaultEnd, FColor::Purple)
 
-	if (Height < Mantle_MaxVaultHeight)
+	if (Height < Profile->Mantle_MaxVaultHeight)
 	{
+		ADV_COUNT_QUERY(LineTrace, Mantle)
 		GetWorld()->LineTraceSingleByProfile(VaultHit, VaultStart, VaultEnd, "BlockAll", Params);
 		if (VaultHit.IsValidBlockingHit())
 		{ 
 			FVector VaultCapLoc = VaultHit.Location;
 			VaultCapLoc.Z += CapHH() + 2;
+			ADV_COUNT_QUERY(Overlap, Mantle)
 			if (GetWorld()->OverlapAnyTestByProfile(VaultCapLoc, FQuat::Identity, "BlockAll", CapShape, Params))
 			{
-				CAPSULE(VaultCapLoc, FColor::Orange)
+				CAPSULE(Mantle, VaultCapLoc, FColor::Orange)
 			}
 			else
 			{
-				CAPSULE(VaultCapLoc, FColor::Green)
-				shouldVault = true;
+				CAPSULE(Mantle, VaultCapLoc, FColor::Green)
+				bShouldVault = true;
 			}	
 		}
 		else if (!VaultHit.bStartPenetrating)
 		{
+			ADV_COUNT_QUERY(Overlap, Mantle)
 			if (GetWorld()->OverlapAnyTestByProfile(VaultEnd, FQuat::Identity, "BlockAll", CapShape, Params))
 			{
-				CAPSULE(VaultEnd, FColor::Orange)
+				CAPSULE(Mantle, VaultEnd, FColor::Orange)
 			}
 			else
 			{
-				SLOG("WE SET THIS")
-				CAPSULE(VaultEnd, FColor::Green)
-				shouldVault = true;
+				SLOG(Mantle, "WE SET THIS")
+				CAPSULE(Mantle, VaultEnd, FColor::Green)
+				bShouldVault = true;
 				bShouldVaultHang = true;
 			}	
 		}
 	}
 
-	const std::string Type = shouldVault ? "Vault" : "Mantle";
-	
-	FVector ShortMantleTarget = GetMantleStartLocation(FrontHit, SurfaceHit, false, Type);
-	FVector TallMantleTarget = GetMantleStartLocation(FrontHit, SurfaceHit, true, Type);
+	return true;
+}
 
-	bool bTallMantle = false;
-	// Check heights for either Mantle or Vault
-	if ((IsMovementMode(MOVE_Walking) && Type == "Mantle" && Height > Mantle_MinTallClimbHeight) ||
-		(IsMovementMode(MOVE_Walking) && Type == "Vault" && Height > Mantle_MinTallVaultHeight))
-		bTallMantle = true;
-	// If we are falling and Velocity is downward
-	else if (IsMovementMode(MOVE_Falling) && (Velocity | FVector::UpVector) < 0)
+int32 UAdvCharacterMovementComponent::TraceMantleFront(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, EQueryScene Scene, int32 MaxTraces, FHitResult& OutFrontHit) const
+{
+	// We want to mantle it if it is above the max step height so we start how checks from here up
+	FVector FrontStart = BaseLoc + FVector::UpVector * (Profile->Mantle_MinShortClimbHeight - 1);
+	const FVector FrontStep = FVector::UpVector * (2.0f * CapHH() - (Profile->Mantle_MinShortClimbHeight - 1)) / (MantleFrontTraces - 1);
+	for (int32 i = 0; i < MaxTraces; i++)
 	{
-		// Don't want to tall mantle if the object is not tall enough for the tall mantle animation which is capsule height
-		if (!GetWorld()->OverlapAnyTestByProfile(TallMantleTarget, FQuat::Identity, "BlockAll", CapShape, Params))
-			bTallMantle = true;
+		ADV_COUNT_QUERY(LineTrace, Mantle)
+		if (LineTraceScene(OutFrontHit, FrontStart, FrontStart + Fwd * CheckDistance, Scene)) return i;
+		FrontStart += FrontStep;
 	}
+	return INDEX_NONE;
+}
 
-	FVector TransitionTarget = bTallMantle ? TallMantleTarget : ShortMantleTarget;
-	CAPSULE(TransitionTarget, FColor::Yellow)
-	// Perform Transition to Mantle
-	CAPSULE(UpdatedComponent->GetComponentLocation(), FColor::Red)
-
-	// The transition montage speed is controlled by the current UpSpeed
-	// If the character was moving upward then we speed up the transition
-	// If the character was moving downward then we slow down the transtion
-	// Makes it feel more realistic
-	float UpSpeed = Velocity | FVector::UpVector;
-	float TransDistance = FVector::Dist(TransitionTarget, UpdatedComponent->GetComponentLocation());
-	TransitionQueuedMontageSpeed = FMath::GetMappedRangeValueClamped(FVector2D(-500, 750), FVector2D(0.9f, 1.2f), UpSpeed);
-	// Delete the old RMS from the SharedPTR and create a new one
-	// RootMotionSource kind of like a tween to drive the capsule from start to target position
-	TransitionRMS.Reset();
-	TransitionRMS = MakeShared<FRootMotionSource_MoveToForce>();
-	// No accumulation
-	TransitionRMS->AccumulateMode = ERootMotionAccumulateMode::Override;
-
-	// Duration of the transition based on how far you are away from the target distance
-	TransitionRMS->Duration = FMath::Clamp(TransDistance / 500.0f, Mantle_MinTransitionTime, Mantle_MaxTransitionTime);
-	SLOG(FString::Printf(TEXT("Duration: %f"), TransitionRMS->Duration))
-	TransitionRMS->StartLocation = UpdatedComponent->GetComponentLocation();
-	TransitionRMS->TargetLocation = TransitionTarget;
-	TransitionName = "Mantle";
-	LastMontage = Type; // ID for OnMontageEnd
-	
-	// Zero out the Velocity
-	Velocity = FVector::ZeroVector;
-	// Remove gravity application
-	SetMovementMode(MOVE_Flying);
-	TransitionRMS_ID = ApplyRootMotionSource(TransitionRMS);
-
-	// Queue animations
-	// Transition Montages are NOT root animations
-	// Transition Montages are 1 second and the speed can be scaled based on the TransitionRMS Duration
-	SetMantleMontages(Type, bTallMantle);
+bool UAdvCharacterMovementComponent::FindBakedMantleLedge(const FAdvLedgeBakeKey& BakeKey, const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, FHitResult& FrontHit, FHitResult& SurfaceHit, float& Height, bool& bShouldVault)
+{
+	const UAdvTraversalSubsystem* Traversal = GetWorld()->GetSubsystem<UAdvTraversalSubsystem>();
+	if (!Traversal) return false;
+
+	// Same window the front traces cover
+	FVector EdgePoint;
+	const FAdvLedgeSegment* Ledge = Traversal->FindLedge(BakeKey, BaseLoc, Fwd, CheckDistance, Profile->Mantle_MinShortClimbHeight - 1, Profile->Mantle_MaxClimbHeight, 2.0f * CapHH(), EdgePoint);
+	if (!Ledge) return false;
+
+	// Wall steepness and surface angle were checked when baking, alignment depends on the character
+	float CosMMAA = Profile->Mantle_CosMaxAlignmentAngle;
+	if ((Fwd | -Ledge->WallNormal) < CosMMAA) return false;
+
+	// Fill in the hits the traces would have found so the rest of the mantle doesn't care where the ledge came from
+	FrontHit = FHitResult(1.0f);
+	FrontHit.bBlockingHit = true;
+	FrontHit.Location = FrontHit.ImpactPoint = EdgePoint;
+	FrontHit.Normal = FrontHit.ImpactNormal = Ledge->WallNormal;
+	SurfaceHit = FHitResult(1.0f);
+	SurfaceHit.bBlockingHit = true;
+	SurfaceHit.Location = SurfaceHit.ImpactPoint = EdgePoint + Fwd * 3;
+	SurfaceHit.Normal = SurfaceHit.ImpactNormal = Ledge->SurfaceNormal;
+	Height = EdgePoint.Z - BaseLoc.Z;
+
+	SLOG(Mantle, FString::Printf(TEXT("Baked Height: %f"), Height))
+	POINT(Mantle, SurfaceHit.Location, FColor::Blue)
 
-	if (Type == "Vault" && bTallMantle == true)
+	// ---- CHECK CLEARANCE ---- //
+	// Static primitives are covered by the baked clearance so only the rest are overlapped
+	const FCollisionQueryParams& Params = AdvancedCharacterOwner->GetIgnoreCharacterParams(GetSceneMobility(EQueryScene::Live));
+	FCollisionShape CapShape = FCollisionShape::MakeCapsule(CapR(), CapHH());
+	float SurfaceCos = FVector::UpVector | SurfaceHit.Normal;
+	float SurfaceSin = FMath::Sqrt(1 - SurfaceCos * SurfaceCos);
+	FVector ClearCapLoc = SurfaceHit.Location + Fwd * CapR() + FVector::UpVector * (CapHH() + 1 + CapR() * 2 * SurfaceSin);
+	ADV_COUNT_QUERY(Overlap, Mantle)
+	if (Ledge->Clearance < 2 * CapHH() + 1 + CapR() * 2 * SurfaceSin || GetWorld()->OverlapAnyTestByProfile(ClearCapLoc, FQuat::Identity, "BlockAll", CapShape, Params))
 	{
-		SLOG("THIS WAS MET")
+		CAPSULE(Mantle, ClearCapLoc, FColor::Red)
+		return false;
 	}
-	
-	return true;
-}
 
-void UAdvCharacterMovementComponent::SetMantleMontages(const std::string& Type, const bool bTallMantle)
-{
-	
-	if (Type == "Mantle")
-	{
-		if (bTallMantle)
+	CAPSULE(Mantle, ClearCapLoc, FColor::Green)
+	SLOG(Mantle, "Can Mantle")
+
+	// ---- CHECK IF SHOULD VAULT ---- //
+	bShouldVault = false;
+	if (Height < Profile->Mantle_MaxVaultHeight && Ledge->bVaultable)
+	{
+		// Same end point as the vault trace, nothing to land on above it means dropping into a hang
+		FVector VaultCapLoc = EdgePoint - Ledge->WallNormal * CapR() * 2;
+		const float VaultEndZ = UpdatedComponent->GetComponentLocation().Z - CapHH() * 3;
+		const bool bVaultDrop = Ledge->VaultFloorZ < VaultEndZ;
+		VaultCapLoc.Z = bVaultDrop ? VaultEndZ : Ledge->VaultFloorZ + CapHH() + 2;
+		ADV_COUNT_QUERY(Overlap, Mantle)
+		if (GetWorld()->OverlapAnyTestByProfile(VaultCapLoc, FQuat::Identity, "BlockAll", CapShape, Params))
 		{
-			TransitionQueuedMontage = Mantle_TallClimbMontage;
-			CharacterOwner->PlayAnimMontage(Mantle_TransitionTallClimbMontage, 1 / TransitionRMS->Duration);
-			if (IsServer()) Proxy_bTallMantle = !Proxy_bTallMantle;
+			CAPSULE(Mantle, VaultCapLoc, FColor::Orange)
 		}
 		else
 		{
-			TransitionQueuedMontage = Mantle_ShortClimbMontage;
-			CharacterOwner->PlayAnimMontage(Mantle_TransitionShortClimbMontage, 1 / TransitionRMS->Duration);
-			if (IsServer()) Proxy_bShortMantle = !Proxy_bShortMantle;
+			CAPSULE(Mantle, VaultCapLoc, FColor::Green)
+			bShouldVault = true;
+			bShouldVaultHang = bVaultDrop;
 		}
 	}
-	else if (Type == "Vault")
+
+	return true;
+}
+
+void UAdvCharacterMovementComponent::SetMantleMontages(EAdvLedgeClass HeightClass)
+{
+	if (IsServer()) PushProxyEvent(EAdvProxyEventType::Mantle, HeightClass, Transition.TargetLocation);
+
+	switch (HeightClass)
 	{
-		if (bTallMantle)
-		{
-			TransitionQueuedMontage = Mantle_TallVaultMontage;
-			CharacterOwner->PlayAnimMontage(Mantle_TransitionTallVaultMontage, 0.5 / TransitionRMS->Duration);
-			if (IsServer()) Proxy_bTallVault = !Proxy_bTallVault;
-		}
-		else
-		{
-			TransitionQueuedMontage = Mantle_ShortVaultMontage;
-			CharacterOwner->PlayAnimMontage(Mantle_TransitionShortVaultMontage, 0.5 / TransitionRMS->Duration);
-			if (IsServer()) Proxy_bShortVault = !Proxy_bShortVault;
-		}
+	case EAdvLedgeClass::TallMantle:
+		Transition.QueuedMontage = GetMontage(EAdvMontage::TallClimb);
+		CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::TransitionTallClimb), 1 / Transition.Duration);
+		break;
+	case EAdvLedgeClass::ShortMantle:
+		Transition.QueuedMontage = GetMontage(EAdvMontage::ShortClimb);
+		CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::TransitionShortClimb), 1 / Transition.Duration);
+		break;
+	case EAdvLedgeClass::TallVault:
+		Transition.QueuedMontage = GetMontage(EAdvMontage::TallVault);
+		CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::TransitionTallVault), 0.5 / Transition.Duration);
+		break;
+	case EAdvLedgeClass::ShortVault:
+		Transition.QueuedMontage = GetMontage(EAdvMontage::ShortVault);
+		CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::TransitionShortVault), 0.5 / Transition.Duration);
+		break;
 	}
 }
 
-FVector UAdvCharacterMovementComponent::GetMantleStartLocation(const FHitResult& FrontHit, const FHitResult& SurfaceHit, const bool bTallMantle, const std::string& Type) const
+FVector UAdvCharacterMovementComponent::GetMantleStartLocation(const FHitResult& FrontHit, const FHitResult& SurfaceHit, EAdvLedgeClass HeightClass) const
 {
 	// Working backwards from the top point to the point in which the capsule must be transitioned to in order to start the animation
 	
 	float CosWallSteepnessAngle = FrontHit.Normal | FVector::UpVector;
 
 	float DownDistance = 0.0f;
-	if (Type == "Mantle")
+	switch (HeightClass)
 	{
-		DownDistance = bTallMantle ? Mantle_MinTallClimbHeight : Mantle_MinShortClimbHeight;
-	}
-	else if (Type == "Vault")
-	{
-		DownDistance = bTallMantle ? Mantle_MinTallVaultHeight : Mantle_MinShortVaultHeight;
+	case EAdvLedgeClass::ShortMantle:	DownDistance = Profile->Mantle_MinShortClimbHeight; break;
+	case EAdvLedgeClass::TallMantle:	DownDistance = Profile->Mantle_MinTallClimbHeight; break;
+	case EAdvLedgeClass::ShortVault:	DownDistance = Profile->Mantle_MinShortVaultHeight; break;
+	case EAdvLedgeClass::TallVault:		DownDistance = Profile->Mantle_MinTallVaultHeight; break;
 	}
 	
 	FVector EdgeTangent = FVector::CrossProduct(SurfaceHit.Normal, FrontHit.Normal).GetSafeNormal();
@@ -1254,25 +1909,31 @@ FVector UAdvCharacterMovementComponent::GetMantleStartLocation(const FHitResult&
 
 bool UAdvCharacterMovementComponent::TryWallRun()
 {
+	ADV_SCOPE_CYCLE_COUNTER(TryWallRun)
+
 	// Must be falling
 	// Horizontal velocity must be faster than Min Speed
 	// Prevents wall run if you have high vertical velocity (Can be changed to what you see fit)
 	if (!IsFalling()) return false;
-	if (Velocity.SizeSquared2D() < pow(WallRun_MinSpeed, 2)) return false;
-	//if (Velocity.Z < -WallRun_MaxVerticalSpeed) return false; <-- Getting rid of this for now since if we are too high we may gain to much vertical before the wall run starts
+	if (Velocity.SizeSquared2D() < Profile->WallRun_MinSpeedSquared) return false;
+	//if (Velocity.Z < -Profile->WallRun_MaxVerticalSpeed) return false; <-- Getting rid of this for now since if we are too high we may gain to much vertical before the wall run starts
 
 	// Set line hits for left and right
 	FVector Start = UpdatedComponent->GetComponentLocation();
 	FVector LeftEnd = Start - UpdatedComponent->GetRightVector() * CapR() * 2;
 	FVector RightEnd = Start + UpdatedComponent->GetRightVector() * CapR() * 2;
-	auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-	FHitResult FloorHit, WallHit, TopHit;
+	const FCollisionQueryParams& Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
+	FHitResult WallHit, TopHit;
 
 	// Check height
-	if (GetWorld()->LineTraceSingleByProfile(FloorHit, Start, Start + FVector::DownVector * (CapHH() + WallRun_MinHeight), "BlockAll", Params)) return false;
+	if (IsGroundWithin(CapHH() + Profile->WallRun_MinHeight)) return false;
 	
 	// Left Cast
-	GetWorld()->LineTraceSingleByProfile(WallHit, Start, LeftEnd, "BlockAll", Params);
+	if (!GetPrefetchedTrace(PREFETCH_WallRunLeft, Start, LeftEnd, WallHit))
+	{
+		ADV_COUNT_QUERY(LineTrace, WallRun)
+		GetWorld()->LineTraceSingleByProfile(WallHit, Start, LeftEnd, "BlockAll", Params);
+	}
 	
 	// Velocity must be point at the wall to some degree just not away from the wall
 	if (WallHit.IsValidBlockingHit() && (Velocity | WallHit.Normal) < 0)
@@ -1282,7 +1943,11 @@ bool UAdvCharacterMovementComponent::TryWallRun()
 	else
 	{
 		// Right Cast
-		GetWorld()->LineTraceSingleByProfile(WallHit, Start, RightEnd, "BlockAll", Params);
+		if (!GetPrefetchedTrace(PREFETCH_WallRunRight, Start, RightEnd, WallHit))
+		{
+			ADV_COUNT_QUERY(LineTrace, WallRun)
+			GetWorld()->LineTraceSingleByProfile(WallHit, Start, RightEnd, "BlockAll", Params);
+		}
 		if (WallHit.IsValidBlockingHit() && (Velocity | WallHit.Normal) < 0)
 		{
 			Safe_bWallRunIsRight = true;
@@ -1298,7 +1963,8 @@ bool UAdvCharacterMovementComponent::TryWallRun()
 	const FVector WallTopStart = FVector(WallHit.Location.X, WallHit.Location.Y, UpdatedComponent->GetComponentLocation().Z) + FVector::UpVector * (CapHH() + 5.0f) + -WallHit.Normal * 5.0f;
 	const FVector WallTopEnd = WallTopStart + FVector::DownVector * CapHH() * 2;
 
-	LINE(WallTopStart, WallTopEnd, FColor::Magenta)
+	LINE(WallRun, WallTopStart, WallTopEnd, FColor::Magenta)
+	ADV_COUNT_QUERY(LineTrace, WallRun)
 	if (GetWorld()->LineTraceSingleByProfile(TopHit, WallTopStart, WallTopEnd, "BlockAll", Params))
 	{
 		if (!TopHit.bStartPenetrating) return false;	
@@ -1308,18 +1974,21 @@ bool UAdvCharacterMovementComponent::TryWallRun()
 	const FVector ProjectedVelocity = FVector::VectorPlaneProject(Velocity, WallHit.Normal);
 
 	// More restrictive than the first check for MinSpeed
-	if (ProjectedVelocity.SizeSquared2D() < pow(WallRun_MinSpeed, 2)) return false;
+	if (ProjectedVelocity.SizeSquared2D() < Profile->WallRun_MinSpeedSquared) return false;
 
 	// Passed all conditions enter wall run
+	CacheWallRunContact(WallHit);
 	Velocity = ProjectedVelocity;
-	Velocity.Z = FMath::Clamp(Velocity.Z, 0.0f, WallRun_MaxVerticalSpeed);
+	Velocity.Z = FMath::Clamp(Velocity.Z, 0.0f, Profile->WallRun_MaxVerticalSpeed);
 	SetMovementMode(MOVE_Custom, CMOVE_WallRun);
-	SLOG("Starting Wall Run");
+	SLOG(WallRun, "Starting Wall Run");
 	return true;
 }
 
 void UAdvCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iterations)
 {
+	ADV_SCOPE_CYCLE_COUNTER(PhysWallRun)
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -1340,19 +2009,19 @@ void UAdvCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iteratio
 		bJustTeleported = false;
 		const float timeTick = GetSimulationTimeStep(remainingTime, Iterations);
 		remainingTime -= timeTick;
+		WallRunContact.TimeRemaining -= timeTick;
 		const FVector OldLocation = UpdatedComponent->GetComponentLocation();
 
 		FVector Start = UpdatedComponent->GetComponentLocation();
 		FVector CastDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
 		FVector End = Safe_bWallRunIsRight ? Start + CastDelta : Start - CastDelta;
-		auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-		float SinPullAwayAngle = FMath::Sin(FMath::DegreesToRadians(WallRun_PullAwayAngle));
-		FHitResult WallHit;
-		GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
-		bool bWantsToPullAway = WallHit.IsValidBlockingHit() && !Acceleration.IsNearlyZero() && (Acceleration.GetSafeNormal() | WallHit.Normal) > SinPullAwayAngle;
+		float SinPullAwayAngle = Profile->WallRun_SinPullAwayAngle;
+		FVector WallNormal;
+		bool bOnWall = FindWallRunWall(Start, End, WallNormal);
+		bool bWantsToPullAway = bOnWall && !Acceleration.IsNearlyZero() && (Acceleration.GetSafeNormal() | WallNormal) > SinPullAwayAngle;
 
 		// Fall off wall
-		if (!WallHit.IsValidBlockingHit() || bWantsToPullAway)
+		if (!bOnWall || bWantsToPullAway)
 		{
 			SetMovementMode(MOVE_Falling);
 			StartNewPhysics(remainingTime, Iterations);
@@ -1360,21 +2029,21 @@ void UAdvCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iteratio
 		}
 
 		// Project acceleration onto the wall
-		Acceleration = FVector::VectorPlaneProject(Acceleration, WallHit.Normal);
+		Acceleration = FVector::VectorPlaneProject(Acceleration, WallNormal);
 		Acceleration.Z = 0.0f;
 		// Apply acceleration
 		CalcVelocity(timeTick, 0.0f, false, GetMaxBrakingDeceleration());
 		// Project Velocity onto the wall
-		Velocity = FVector::VectorPlaneProject(Velocity, WallHit.Normal);
+		Velocity = FVector::VectorPlaneProject(Velocity, WallNormal);
 		// How much acceleration is tangent to the wall
 		// If our input is along the wall we get a value closer to 1 (-1 if we are against the direction along the wall)
 		float TangentAccel = Acceleration.GetSafeNormal() | Velocity.GetSafeNormal2D();
 		bool bVelUp = Velocity.Z > 0.0f;
 		// Apply gravity (they let go of input or go against the flow)
 		// Define the pattern using a curve of how gravity effects 
-		Velocity.Z += GetGravityZ() * WallRun_GravityScaleCurve->GetFloatValue(bVelUp ? 0.0f : TangentAccel) * timeTick;
+		Velocity.Z += GetGravityZ() * Profile->WallRun_GravityScaleSamples->Evaluate(bVelUp ? 0.0f : TangentAccel) * timeTick;
 		// Losing too much velocity or too much downward velocity
-		if (Velocity.SizeSquared2D() < pow(WallRun_MinSpeed, 2) || Velocity.Z < -WallRun_MaxVerticalSpeed)
+		if (Velocity.SizeSquared2D() < Profile->WallRun_MinSpeedSquared || Velocity.Z < -Profile->WallRun_MaxVerticalSpeed)
 		{
 			SetMovementMode(MOVE_Falling);
 			StartNewPhysics(remainingTime, Iterations);
@@ -1394,7 +2063,7 @@ void UAdvCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iteratio
 			// Move us by the delta of velocity
 			SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
 			// Move them at the wall
-			FVector WallAttractionDelta = -WallHit.Normal * WallRun_AttractionForce * timeTick;
+			FVector WallAttractionDelta = -WallNormal * Profile->WallRun_AttractionForce * timeTick;
 			SafeMoveUpdatedComponent(WallAttractionDelta, UpdatedComponent->GetComponentQuat(), true, Hit);
 		}
 		if (UpdatedComponent->GetComponentLocation() == OldLocation)
@@ -1409,113 +2078,98 @@ void UAdvCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iteratio
 	FVector Start = UpdatedComponent->GetComponentLocation();
 	FVector CastDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
 	FVector End = Safe_bWallRunIsRight ? Start + CastDelta : Start - CastDelta;
-	auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-	FHitResult FloorHit, WallHit;
-	GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
-	GetWorld()->LineTraceSingleByProfile(FloorHit, Start, Start + FVector::DownVector * (CapHH() + WallRun_MinHeight * 0.5f), "BlockAll", Params);
-	if (FloorHit.IsValidBlockingHit() || !WallHit.IsValidBlockingHit() || Velocity.SizeSquared2D() < pow(WallRun_MinSpeed, 2))
+	FVector WallNormal;
+	// Traced so every move confirms the wall the substeps ran on
+	if (IsGroundWithin(CapHH() + Profile->WallRun_MinHeight * 0.5f) || !FindWallRunWall(Start, End, WallNormal, false) || Velocity.SizeSquared2D() < Profile->WallRun_MinSpeedSquared)
 	{
 		SetMovementMode(MOVE_Falling);
 	}
 }
 
+bool UAdvCharacterMovementComponent::FindWallRunWall(const FVector& Start, const FVector& End, FVector& OutNormal, bool bAllowContact)
+{
+	const FVector Delta = End - Start;
+	// Replays restore the contact with the move (see PrepMoveFor) so they take the same path the server did
+	if (bAllowContact && WallRunContact.Component.IsValid() && WallRunContact.TimeRemaining > 0.0f)
+	{
+		// Same test as the trace but against the cached plane
+		const float Facing = Delta | WallRunContact.Normal;
+		if (Facing < 0.0f)
+		{
+			const float Time = ((WallRunContact.Point - Start) | WallRunContact.Normal) / Facing;
+			if (Time >= 0.0f && Time <= 1.0f && WallRunContact.Region.IsInsideOrOn(Start + Delta * Time))
+			{
+				OutNormal = WallRunContact.Normal;
+				return true;
+			}
+		}
+	}
+
+	FHitResult WallHit;
+	ADV_COUNT_QUERY(LineTrace, WallRun)
+	GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", AdvancedCharacterOwner->GetIgnoreCharacterParams());
+	CacheWallRunContact(WallHit);
+	if (!WallHit.IsValidBlockingHit()) return false;
+
+	OutNormal = WallHit.Normal;
+	return true;
+}
+
+void UAdvCharacterMovementComponent::CacheWallRunContact(const FHitResult& WallHit)
+{
+	WallRunContact.Component.Reset();
+
+	// Only static walls are guaranteed to stay where the trace found them
+	UPrimitiveComponent* Component = WallHit.GetComponent();
+	if (!WallHit.IsValidBlockingHit() || !Component || Component->Mobility != EComponentMobility::Static) return;
+
+	WallRunContact.Component = Component;
+	WallRunContact.Point = WallHit.ImpactPoint;
+	WallRunContact.Normal = WallHit.Normal;
+	// Not the component's bounds, a wall with gaps or corners would be reported where the trace hits nothing
+	WallRunContact.Region = FBox::BuildAABB(WallHit.ImpactPoint, FVector(Profile->WallRun_ContactCacheExtent));
+	WallRunContact.TimeRemaining = Profile->WallRun_ContactCacheDuration;
+}
+
 #pragma endregion Wall Run
 
 #pragma region Climbing
 
 bool UAdvCharacterMovementComponent::TryHang()
 {
-	if (!IsMovementMode(MOVE_Falling)) return false;
-	
+	ADV_SCOPE_CYCLE_COUNTER(TryHang)
 
-	auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-	TArray<FOverlapResult> OverlapResults;
+	if (!IsMovementMode(MOVE_Falling)) return false;
 
 	// Move detection to the players head then move 2 capsules in front
 	// Can parameterise the box size to give more accessibility to what can be grabbed
-	FVector ColLoc = UpdatedComponent->GetComponentLocation() + FVector::UpVector * CapHH() + UpdatedComponent->GetForwardVector() * CapR() * 3;
-	auto ColSphere = FCollisionShape::MakeSphere(100);
-
-	SPHERE(ColLoc, 200, FColor::Emerald)	
-	if (!GetWorld()->OverlapMultiByChannel(OverlapResults, ColLoc, FQuat::Identity, ECC_WorldStatic, ColSphere, Params)) return false;
-	
-	AActor* ClimbPoint = nullptr;
-
-	float MaxHeight = -1e20;
-	bool bIsSwingable = false;
-	for (FOverlapResult Result : OverlapResults)
-	{
-		if (Result.GetActor()->ActorHasTag("Climb Point") || Result.GetActor()->ActorHasTag("Swing Point"))
-		{
-			float Height = Result.GetActor()->GetActorLocation().Z;
-			if (Height > MaxHeight)
-			{
-				MaxHeight = Height;
-				ClimbPoint = Result.GetActor();
-				if (Result.GetActor()->ActorHasTag("Swing Point"))
-				{
-					bIsSwingable = true;
-				}
-				else
-				{
-					bIsSwingable = false;
-				}
-			}
-		}
-	}
-	if (!IsValid(ClimbPoint)) return false;
+	FVector ColLoc = GetHangSearchCenter();
 
-	FVector DirectionProperty;
-	
-	if (FProperty* FoundProp = ClimbPoint->GetClass()->FindPropertyByName(TEXT("Direction")))
-	{
-		FStructProperty* StructProp = CastField<FStructProperty>(FoundProp);
-		if (StructProp && StructProp->Struct == TBaseStructure<FVector>::Get())
-		{
-			void* ValuePtr = StructProp->ContainerPtrToValuePtr<void>(ClimbPoint);
-			DirectionProperty = *reinterpret_cast<FVector*>(ValuePtr);
-		}
-		else
-		{
-			return false;
-		}
-	}
-	else
-	{
-		return false;
-	}
-	
-	// Where the capsule should be
-	// Back away from the wall -> 1.01 for a bit of tolerance from the wall
+	SPHERE(Hang, ColLoc, 100, FColor::Emerald)
 	FVector TargetLocation;
 	FQuat TargetRotation;
+	const FAdvGrabPoint* ClimbPoint = FindHangTarget(ColLoc, TargetLocation, TargetRotation);
+	if (!ClimbPoint) return false;
+
+	const bool bIsSwingable = ClimbPoint->bSwingable;
 	
-	float DirectionPropertyDot = GetForwardVector() | DirectionProperty;
-	if (DirectionPropertyDot > 0.0f)
-	{
-		DirectionProperty = -DirectionProperty;
-	}
-	
-	if (bIsSwingable)
+	// Test if the character can reach this goal -> Including the movement to said goal not just if they fit in the target
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	FHitResult Hit;
+	if (const FPrefetchedTrace* Prefetched = FindPrefetchedTrace(PREFETCH_HangReach, Start, TargetLocation))
 	{
-		TargetLocation = ClimbPoint->GetActorLocation() + DirectionProperty * CapR() + FVector::DownVector * CapHH();
-		TargetRotation = FRotationMatrix::MakeFromXZ(-DirectionProperty, FVector::UpVector).ToQuat();
+		if (Prefetched->Hit.bBlockingHit) return false;
+		// Static geometry was swept ahead of the move, the rest may have moved since
+		ADV_COUNT_QUERY(Sweep, Hang)
+		if (SweepHangReach(Start, TargetLocation, EQueryScene::Live, Hit)) return false;
 	}
 	else
 	{
-		TargetLocation = ClimbPoint->GetActorLocation() + DirectionProperty * CapR() * 1.01f + FVector::DownVector * CapHH();
-		TargetRotation = FRotationMatrix::MakeFromXZ(-DirectionProperty, FVector::UpVector).ToQuat();
+		ADV_COUNT_QUERY(Sweep, Hang)
+		if (SweepHangReach(Start, TargetLocation, EQueryScene::All, Hit)) return false;
 	}
-	
-	// Test if the character can reach this goal -> Including the movement to said goal not just if they fit in the target
-	FTransform CurrentTransform = UpdatedComponent->GetComponentTransform();
-	FHitResult Hit, ReturnHit;
-	// Sweep to true so it actually simulates this movement and checks if there was any collision
-	SafeMoveUpdatedComponent(TargetLocation - UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentQuat(), true, Hit);
-	FVector ResultLocation = UpdatedComponent->GetComponentLocation();
-	// Move them back
-	SafeMoveUpdatedComponent(CurrentTransform.GetLocation() - ResultLocation, TargetRotation, false, ReturnHit);
-	if (!ResultLocation.Equals(TargetLocation)) return false;
+	// Face the grab point now, the transition only moves the capsule
+	SafeMoveUpdatedComponent(FVector::ZeroVector, TargetRotation, false, Hit);
 
 	// Passed all conditions
 	bOrientRotationToMovement = false;
@@ -1523,46 +2177,70 @@ bool UAdvCharacterMovementComponent::TryHang()
 	float UpSpeed = Velocity | FVector::UpVector;
 	float TransDistance = FVector::Dist(TargetLocation, UpdatedComponent->GetComponentLocation());
 
-	TransitionQueuedMontageSpeed = FMath::GetMappedRangeValueClamped(FVector2D(-500, 750), FVector2D(0.9f, 1.2f), UpSpeed);
-	TransitionRMS.Reset();
-	TransitionRMS = MakeShared<FRootMotionSource_MoveToForce>();
-	TransitionRMS->AccumulateMode = ERootMotionAccumulateMode::Override;
+	FAdvTransition HangTransition;
+	HangTransition.Kind = bIsSwingable ? EAdvTransitionKind::Swing : EAdvTransitionKind::Hang;
+	HangTransition.TargetLocation = TargetLocation;
+	HangTransition.TargetRotation = TargetRotation;
+	HangTransition.Duration = FMath::Clamp(TransDistance / 500.0f, Profile->Hang_MinTransitionTime, Profile->Hang_MaxTransitionTime);
+	HangTransition.QueuedMontage = bIsSwingable ? GetMontage(EAdvMontage::Swing) : nullptr;
+	HangTransition.QueuedMontageSpeed = FMath::GetMappedRangeValueClamped(FVector2D(-500, 750), FVector2D(0.9f, 1.2f), UpSpeed);
+	SLOG(Hang, FString::Printf(TEXT("Duration: %f"), HangTransition.Duration))
 
-	TransitionRMS->Duration = FMath::Clamp(TransDistance / 500.0f, Hang_MinTransitionTime, Hang_MaxTransitionTime);
-	SLOG(FString::Printf(TEXT("Duration: %f"), TransitionRMS->Duration))
-	TransitionRMS->StartLocation = UpdatedComponent->GetComponentLocation();
-	TransitionRMS->TargetLocation = TargetLocation;
-
-	Velocity = FVector::ZeroVector;
-	SetMovementMode(MOVE_Flying);
-	TransitionRMS_ID = ApplyRootMotionSource(TransitionRMS);
+	StartTransition(HangTransition);
 
 	if (bIsSwingable)
 	{
-		TransitionQueuedMontage = Swing_Montage;
-		TransitionName = "Swing";
-		CharacterOwner->PlayAnimMontage(Swing_TransitionMontage, 0.5 / TransitionRMS->Duration);
+		CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::SwingTransition), 0.5 / Transition.Duration);
 	}
 	else
 	{
-		TransitionQueuedMontage = nullptr;
-		TransitionName = "Hang";
-		CharacterOwner->PlayAnimMontage(Hang_TransitionMontage, 1 / TransitionRMS->Duration);	
+		CharacterOwner->PlayAnimMontage(GetMontage(EAdvMontage::HangTransition), 1 / Transition.Duration);	
 	}
 
 	return true;
 }
 
+const FAdvGrabPoint* UAdvCharacterMovementComponent::FindHangTarget(const FVector& SearchCenter, FVector& OutLocation, FQuat& OutRotation) const
+{
+	const UAdvTraversalSubsystem* Traversal = GetWorld()->GetSubsystem<UAdvTraversalSubsystem>();
+	if (!Traversal) return nullptr;
+
+	// Grab points are registered with their direction and type already resolved, so there is nothing else to look up
+	const FAdvGrabPoint* ClimbPoint = Traversal->FindHighestGrabPoint(SearchCenter, 100);
+	if (!ClimbPoint) return nullptr;
+
+	// Where the capsule should be
+	// Back away from the wall -> 1.01 for a bit of tolerance from the wall
+	// Flip the direction if we are approaching the point from behind
+	const bool bFromBehind = (UpdatedComponent->GetForwardVector() | ClimbPoint->Direction) > 0.0f;
+	const FVector Direction = bFromBehind ? -ClimbPoint->Direction : ClimbPoint->Direction;
+	OutRotation = ClimbPoint->Rotations[bFromBehind ? 1 : 0];
+	OutLocation = ClimbPoint->Location + Direction * CapR() * (ClimbPoint->bSwingable ? 1.0f : 1.01f) + FVector::DownVector * CapHH();
+	return ClimbPoint;
+}
+
+bool UAdvCharacterMovementComponent::SweepHangReach(const FVector& Start, const FVector& End, EQueryScene Scene, FHitResult& OutHit) const
+{
+	// Sweeps the capsule the way moving it there would, without moving it
+	return GetWorld()->SweepSingleByChannel(OutHit, Start, End, UpdatedComponent->GetComponentQuat(), UpdatedComponent->GetCollisionObjectType(),
+		GetPawnCapsuleCollisionShape(SHRINK_None), AdvancedCharacterOwner->GetIgnoreCharacterParams(GetSceneMobility(Scene)), FCollisionResponseParams(UpdatedPrimitive->GetCollisionResponseToChannels()));
+}
+
 bool UAdvCharacterMovementComponent::TryClimb()
 {
+	ADV_SCOPE_CYCLE_COUNTER(TryClimb)
+
 	if (!IsFalling() || !Safe_bCanClimbAgain) return false;
 
 	FHitResult SurfaceHit;
 	FHitResult ClimbResult;
 	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector End = Start + UpdatedComponent->GetForwardVector() * Climb_ReachDistance;
-	auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-	GetWorld()->LineTraceSingleByProfile(SurfaceHit, Start, End, "BlockAll", Params);
+	FVector End = Start + UpdatedComponent->GetForwardVector() * Profile->Climb_ReachDistance;
+	if (!GetPrefetchedTrace(PREFETCH_ClimbReach, Start, End, SurfaceHit))
+	{
+		ADV_COUNT_QUERY(LineTrace, Climb)
+		GetWorld()->LineTraceSingleByProfile(SurfaceHit, Start, End, "BlockAll", AdvancedCharacterOwner->GetIgnoreCharacterParams());
+	}
 	
 	if (!SurfaceHit.IsValidBlockingHit()) return false;
 	
@@ -1577,7 +2255,7 @@ bool UAdvCharacterMovementComponent::TryClimb()
 
 	bOrientRotationToMovement = false;
 
-	ClimbTimeRemaining = Climb_MaxDuration;
+	ClimbTimeRemaining = Profile->Climb_MaxDuration;
 	Safe_bCanClimbAgain = false;
 	
 	return true;
@@ -1585,6 +2263,8 @@ bool UAdvCharacterMovementComponent::TryClimb()
 
 void UAdvCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
 {
+	ADV_SCOPE_CYCLE_COUNTER(PhysClimb)
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -1605,13 +2285,13 @@ void UAdvCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations
 	}
 
 	ClimbMantleCheckAccumulator += deltaTime;
-	if (ClimbMantleCheckAccumulator >= Climb_MantleCheckInterval)
+	if (ClimbMantleCheckAccumulator >= Profile->Climb_MantleCheckInterval)
 	{
 		ClimbMantleCheckAccumulator = 0.0f;
 
 		if (TryMantle())
 		{
-			SLOG("Successfully Mantled from climb")
+			SLOG(Mantle, "Successfully Mantled from climb")
 			return;
 		}
 	}
@@ -1631,12 +2311,15 @@ void UAdvCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations
 	bJustTeleported = false;
 	Iterations++;
 	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
-	FHitResult SurfaceHit, FloorHit;
-	auto Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
-	GetWorld()->LineTraceSingleByProfile(SurfaceHit, OldLocation, OldLocation + UpdatedComponent->GetForwardVector() * Climb_ReachDistance, "BlockAll", Params);
-	GetWorld()->LineTraceSingleByProfile(FloorHit, OldLocation, OldLocation + FVector::DownVector * CapHH() * 1.2f, "BlockAll", Params);
+	FHitResult SurfaceHit;
+	const FVector ReachEnd = OldLocation + UpdatedComponent->GetForwardVector() * Profile->Climb_ReachDistance;
+	if (!GetPrefetchedTrace(PREFETCH_ClimbReach, OldLocation, ReachEnd, SurfaceHit))
+	{
+		ADV_COUNT_QUERY(LineTrace, Climb)
+		GetWorld()->LineTraceSingleByProfile(SurfaceHit, OldLocation, ReachEnd, "BlockAll", AdvancedCharacterOwner->GetIgnoreCharacterParams());
+	}
 
-	if (!SurfaceHit.IsValidBlockingHit() || FloorHit.IsValidBlockingHit())
+	if (!SurfaceHit.IsValidBlockingHit() || IsGroundWithin(CapHH() * 1.2f))
 	{
 		SetMovementMode(MOVE_Falling);
 		StartNewPhysics(deltaTime, Iterations);
@@ -1652,10 +2335,10 @@ void UAdvCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations
 	const bool bVelUp = Acceleration.Z > 0.0f;
 	if (!bVelUp)
 	{
-		Velocity.Z += GetGravityZ() * Climb_GravityScaleCurve * deltaTime;
+		Velocity.Z += GetGravityZ() * Profile->Climb_GravityScaleCurve * deltaTime;
 	}
 	
-	if (Velocity.Z < Climb_MaxDownwardVelocity)
+	if (Velocity.Z < Profile->Climb_MaxDownwardVelocity)
 	{
 		SetMovementMode(MOVE_Falling);
 		StartNewPhysics(deltaTime, Iterations);
@@ -1667,7 +2350,7 @@ void UAdvCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations
 	{
 		FHitResult Hit;
 		SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
-		FVector WallAttractionDelta = -SurfaceHit.Normal * WallRun_AttractionForce * deltaTime;
+		FVector WallAttractionDelta = -SurfaceHit.Normal * Profile->WallRun_AttractionForce * deltaTime;
 		SafeMoveUpdatedComponent(WallAttractionDelta , UpdatedComponent->GetComponentQuat(), true, Hit);
 	}
 
@@ -1676,43 +2359,449 @@ void UAdvCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations
 
 #pragma endregion Climbing
 
+#pragma region Traversal Probes
+
+void UAdvCharacterMovementComponent::SubmitTraversalProbes(float DeltaSeconds)
+{
+	// Replays never consume their results, the server probes for the client's moves itself
+	if (!Setting_AsyncTraversalProbes || CharacterOwner->bClientUpdating) return;
+
+	// Only what a Try* of the next move could use, a probe that wasn't submitted falls back to the synchronous check
+	// Mantles need the jump input, the passive climb and wall run checks need the budget to let the next move probe
+	const bool bJumpHeld = AdvancedCharacterOwner->bPressedAdvancedJump && (IsMovementMode(MOVE_Walking) || IsFalling() || IsClimbing());
+	const bool bPassiveDue = IsFalling() && IsTraversalProbeDueNextMove(DeltaSeconds);
+	const bool bWantsFront = bJumpHeld || (bPassiveDue && Safe_bCanClimbAgain);
+	const bool bWantsWall = bPassiveDue && Velocity.SizeSquared2D() >= Profile->WallRun_MinSpeedSquared;
+	if (!bWantsFront && !bWantsWall) return;
+
+	UWorld* World = GetWorld();
+	const FCollisionQueryParams& Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+	const FVector Fwd = UpdatedComponent->GetForwardVector().GetSafeNormal2D();
+	// The results are consumed at the start of the next move, which starts here
+	// Inflated by one move of travel for the turn and speed change the Try* checks of that move can start with
+	const FVector Loc = UpdatedComponent->GetComponentLocation();
+	const float Margin = Velocity.Size() * DeltaSeconds + 10.0f;
+	const FVector BaseLoc = Loc + FVector::DownVector * CapHH();
+
+	// ---- FRONT ---- //
+	// Covers every front trace of TryMantle and the reach trace of TryClimb
+	if (bWantsFront)
+	{
+		const float FrontDepth = Profile->Probe_FrontDepth;
+		const float FrontBottom = Profile->Mantle_MinShortClimbHeight - 1;
+		const float FrontHalfHeight = (2.0f * CapHH() - FrontBottom) * 0.5f;
+		const FVector FrontCenter = BaseLoc + Fwd * FrontDepth * 0.5f + FVector::UpVector * (FrontBottom + FrontHalfHeight);
+		const FCollisionShape FrontBox = FCollisionShape::MakeBox(FVector(FrontDepth * 0.5f + Margin, CapR() + Margin, FrontHalfHeight + Margin));
+		ADV_COUNT_QUERY(Overlap, Probe)
+		Probe_FrontHandle = World->AsyncOverlapByProfile(FrontCenter, Rotation, "BlockAll", FrontBox, Params);
+	}
+
+	if (!bWantsWall) return;
+
+	// ---- WALL ---- //
+	// Both side traces of TryWallRun
+	const FCollisionShape WallBox = FCollisionShape::MakeBox(FVector(CapR() + Margin, CapR() * 2 + Margin, Margin));
+	ADV_COUNT_QUERY(Overlap, Probe)
+	Probe_WallHandle = World->AsyncOverlapByProfile(Loc, Rotation, "BlockAll", WallBox, Params);
+	// Wall run is not allowed close to the floor, shortened by the margin so we never reject a valid wall run
+	const float FloorDistance = FMath::Max(CapHH() + Profile->WallRun_MinHeight - Margin, 0.0f);
+	ADV_COUNT_QUERY(LineTrace, Probe)
+	Probe_FloorHandle = World->AsyncLineTraceByProfile(EAsyncTraceType::Single, Loc, Loc + FVector::DownVector * FloorDistance, "BlockAll", Params);
+}
+
+void UAdvCharacterMovementComponent::ConsumeTraversalProbes()
+{
+	// Replayed moves keep the mask they were originally simulated with (see PrepMoveFor)
+	// The server reads the probes it submitted after the client's previous move, the client has no say in which checks it runs
+	if (!Setting_AsyncTraversalProbes || CharacterOwner->bClientUpdating) return;
+
+	UWorld* World = GetWorld();
+	FOverlapDatum OverlapData;
+	FTraceDatum TraceData;
+	uint8 Mask = PROBE_All;
+
+	// A result that is not ready (or was never submitted) keeps its bit so we fall back to the synchronous checks
+	if (World->QueryOverlapData(Probe_FrontHandle, OverlapData) && OverlapData.OutOverlaps.IsEmpty())
+	{
+		Mask &= ~(PROBE_Mantle | PROBE_Climb);
+	}
+	if (World->QueryOverlapData(Probe_WallHandle, OverlapData) && OverlapData.OutOverlaps.IsEmpty())
+	{
+		Mask &= ~PROBE_WallRun;
+	}
+	if (World->QueryTraceData(Probe_FloorHandle, TraceData) && TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit)
+	{
+		Mask &= ~PROBE_WallRun;
+	}
+
+	// Only valid for the move straight after the one that submitted them
+	Probe_FrontHandle = FTraceHandle();
+	Probe_WallHandle = FTraceHandle();
+	Probe_FloorHandle = FTraceHandle();
+
+	Safe_TraversalProbeMask = Mask;
+}
+
+bool UAdvCharacterMovementComponent::CanTryTraversal(ETraversalProbe Probe) const
+{
+	// Passive probes only run on the moves the budget left them
+	if ((Probe & PROBE_Passive) && !Safe_bTraversalProbeDue) return false;
+	return !Setting_AsyncTraversalProbes || (Safe_TraversalProbeMask & Probe) != 0;
+}
+
+void UAdvCharacterMovementComponent::UpdateTraversalProbeSchedule(float DeltaSeconds)
+{
+	// Driven by move time only so the moves picked don't depend on the frame rate
+	if (TraversalProbeInterval <= 1)
+	{
+		Safe_TraversalProbeAccumulator = 0.0f;
+		Safe_bTraversalProbeDue = true;
+		return;
+	}
+
+	const float Period = TraversalProbeInterval * Budget_ProbeFrameTime;
+	Safe_TraversalProbeAccumulator += DeltaSeconds;
+	Safe_bTraversalProbeDue = Safe_TraversalProbeAccumulator >= Period;
+	if (Safe_bTraversalProbeDue)
+	{
+		Safe_TraversalProbeAccumulator = FMath::Fmod(Safe_TraversalProbeAccumulator, Period);
+	}
+}
+
+bool UAdvCharacterMovementComponent::IsTraversalProbeDueNextMove(float DeltaSeconds) const
+{
+	if (TraversalProbeInterval <= 1) return true;
+	// Assumes the next move is as long as this one, guessing wrong only costs the synchronous checks
+	return Safe_TraversalProbeAccumulator + DeltaSeconds >= TraversalProbeInterval * Budget_ProbeFrameTime;
+}
+
+void UAdvCharacterMovementComponent::SetTraversalProbeInterval(int32 Interval, int32 Phase)
+{
+	if (TraversalProbeInterval == Interval) return;
+
+	// Only characters nobody predicts are throttled, so the phase can change at any time
+	TraversalProbeInterval = static_cast<uint8>(Interval);
+	Safe_TraversalProbeAccumulator = Phase * Budget_ProbeFrameTime;
+}
+
+#pragma endregion Traversal Probes
+
+#pragma region Parallel Prefetch
+
+void UAdvCharacterMovementComponent::PrefetchMoveQueries(float DeltaSeconds) const
+{
+	ADV_SCOPE_CYCLE_COUNTER(PrefetchMoveQueries)
+
+	// Same starts and ends as the call sites, a move that went elsewhere since simply misses the cache
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	bool bPrefetchMantle = false;
+	// Gated on the schedule of the coming move, not the last one. The async probe mask isn't known until the move takes it so it is left out
+	const bool bPassiveDue = IsTraversalProbeDueNextMove(DeltaSeconds);
+	if (IsCustomMovementMode(CMOVE_Slide))
+	{
+		if (Velocity.SizeSquared() < Profile->Slide_MinExitSpeedSquared) IsGroundWithin(CapHH() * 2.5f, EQueryScene::Static);
+	}
+	else if (IsClimbing())
+	{
+		PrefetchTrace(PREFETCH_ClimbReach, Start, Start + UpdatedComponent->GetForwardVector() * Profile->Climb_ReachDistance);
+		IsGroundWithin(CapHH() * 1.2f, EQueryScene::Static);
+	}
+	else if (IsFalling())
+	{
+		if (Safe_bCanClimbAgain && bPassiveDue)
+		{
+			PrefetchTrace(PREFETCH_ClimbReach, Start, Start + UpdatedComponent->GetForwardVector() * Profile->Climb_ReachDistance);
+			// TryClimb mantles instead when it can
+			const AActor* ClimbWall = PrefetchedTraces[PREFETCH_ClimbReach].Hit.GetActor();
+			bPrefetchMantle = ClimbWall && ClimbWall->ActorHasTag("Climb Wall");
+		}
+		if (Velocity.SizeSquared2D() >= Profile->WallRun_MinSpeedSquared && bPassiveDue && !IsGroundWithin(CapHH() + Profile->WallRun_MinHeight, EQueryScene::Static))
+		{
+			const FVector SideDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
+			PrefetchTrace(PREFETCH_WallRunLeft, Start, Start - SideDelta);
+			PrefetchTrace(PREFETCH_WallRunRight, Start, Start + SideDelta);
+		}
+	}
+
+	// The jump input tries a mantle first and a hang after
+	if (AdvancedCharacterOwner->bPressedAdvancedJump)
+	{
+		bPrefetchMantle |= (IsMovementMode(MOVE_Walking) && !IsCrouching()) || IsFalling() || IsCustomMovementMode(CMOVE_Climb);
+
+		FVector HangLocation;
+		FQuat HangRotation;
+		if (IsFalling() && FindHangTarget(GetHangSearchCenter(), HangLocation, HangRotation))
+		{
+			FPrefetchedTrace& Prefetched = StartPrefetch(PREFETCH_HangReach, Start, HangLocation);
+			ADV_COUNT_QUERY(Sweep, Prefetch)
+			SweepHangReach(Start, HangLocation, EQueryScene::Static, Prefetched.Hit);
+		}
+	}
+
+	// Once every level has baked ledges TraceMantleLedge leaves static geometry to them
+	const UAdvTraversalSubsystem* Traversal = GetWorld()->GetSubsystem<UAdvTraversalSubsystem>();
+	if (bPrefetchMantle && !(Traversal && Traversal->HasCompleteLedgeData(GetLedgeBakeKey())))
+	{
+		FVector BaseLoc, Fwd;
+		float CheckDistance;
+		GetMantleProbe(BaseLoc, Fwd, CheckDistance);
+		FPrefetchedTrace& Prefetched = StartPrefetch(PREFETCH_MantleFront, BaseLoc, BaseLoc + Fwd * CheckDistance);
+		Prefetched.HitIndex = TraceMantleFront(BaseLoc, Fwd, CheckDistance, EQueryScene::Static, MantleFrontTraces, Prefetched.Hit);
+	}
+}
+
+UAdvCharacterMovementComponent::FPrefetchedTrace& UAdvCharacterMovementComponent::StartPrefetch(EPrefetchTrace Trace, const FVector& Start, const FVector& End) const
+{
+	FPrefetchedTrace& Prefetched = PrefetchedTraces[Trace];
+	Prefetched.Start = Start;
+	Prefetched.End = End;
+	Prefetched.Frame = GFrameCounter;
+	Prefetched.HitIndex = INDEX_NONE;
+	return Prefetched;
+}
+
+void UAdvCharacterMovementComponent::PrefetchTrace(EPrefetchTrace Trace, const FVector& Start, const FVector& End) const
+{
+	FPrefetchedTrace& Prefetched = StartPrefetch(Trace, Start, End);
+	ADV_COUNT_QUERY(LineTrace, Prefetch)
+	LineTraceScene(Prefetched.Hit, Start, End, EQueryScene::Static);
+}
+
+const UAdvCharacterMovementComponent::FPrefetchedTrace* UAdvCharacterMovementComponent::FindPrefetchedTrace(EPrefetchTrace Trace, const FVector& Start, const FVector& End) const
+{
+	// Only good for the move of the frame it was made in
+	const FPrefetchedTrace& Prefetched = PrefetchedTraces[Trace];
+	if (Prefetched.Frame != GFrameCounter || !Prefetched.Start.Equals(Start, UE_KINDA_SMALL_NUMBER) || !Prefetched.End.Equals(End, UE_KINDA_SMALL_NUMBER)) return nullptr;
+	return &Prefetched;
+}
+
+bool UAdvCharacterMovementComponent::GetPrefetchedTrace(EPrefetchTrace Trace, const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	const FPrefetchedTrace* Prefetched = FindPrefetchedTrace(Trace, Start, End);
+	if (!Prefetched) return false;
+
+	// Anything but static geometry may have moved since, so that part is traced now
+	OutHit = Prefetched->Hit;
+	FHitResult LiveHit;
+	ADV_COUNT_QUERY(LineTrace, PrefetchLive)
+	if (LineTraceScene(LiveHit, Start, End, EQueryScene::Live) && (!OutHit.bBlockingHit || LiveHit.Distance < OutHit.Distance)) OutHit = LiveHit;
+	return true;
+}
+
+#pragma endregion Parallel Prefetch
+
+#pragma region Simulated Proxy Detail
+
+float UAdvCharacterMovementComponent::GetProxySignificance(const FTransform& Viewpoint) const
+{
+	const FVector ToCharacter = UpdatedComponent->GetComponentLocation() - Viewpoint.GetLocation();
+	const float Distance = ToCharacter.Size();
+	// Anything close enough to bump into counts as on screen
+	const bool bOnScreen = Distance < CapR() * 10 || (ToCharacter | Viewpoint.GetRotation().GetForwardVector()) > Distance * 0.4f;
+
+	// A little slack before dropping a level so proxies on a threshold don't flip every update
+	const float FullDistance = Proxy_FullDetailDistance * (ProxyDetail == EAdvProxyDetail::Full ? 1.1f : 1.0f);
+	const float ReducedDistance = Proxy_ReducedDetailDistance * (ProxyDetail != EAdvProxyDetail::Minimal ? 1.1f : 1.0f);
+
+	if (bOnScreen && Distance < FullDistance) return 2.0f;
+	if (Distance < ReducedDistance && (bOnScreen || Distance < FullDistance)) return 1.0f;
+	return 0.0f;
+}
+
+void UAdvCharacterMovementComponent::SetProxyDetail(EAdvProxyDetail NewDetail)
+{
+	if (ProxyDetail == NewDetail) return;
+	ProxyDetail = NewDetail;
+
+	const float TickInterval = NewDetail == EAdvProxyDetail::Full ? 0.0f : NewDetail == EAdvProxyDetail::Reduced ? Proxy_ReducedTickInterval : Proxy_MinimalTickInterval;
+	SetComponentTickInterval(TickInterval);
+	if (USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh())
+	{
+		Mesh->SetComponentTickInterval(TickInterval);
+		Mesh->VisibilityBasedAnimTickOption = NewDetail == EAdvProxyDetail::Minimal ? EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered : ProxyAnimTickOption;
+	}
+
+	// The side was not traced while the proxy was only interpolating
+	if (NewDetail == EAdvProxyDetail::Full && IsWallRunning())
+	{
+		UpdateProxyWallRunSide();
+	}
+}
+
+void UAdvCharacterMovementComponent::UpdateProxyWallRunSide()
+{
+	FVector Start = UpdatedComponent->GetComponentLocation();
+	FVector End = Start + UpdatedComponent->GetRightVector() * CapR() * 2;
+	const FCollisionQueryParams& Params = AdvancedCharacterOwner->GetIgnoreCharacterParams();
+	FHitResult WallHit;
+	ADV_COUNT_QUERY(LineTrace, WallRun)
+	Safe_bWallRunIsRight = GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
+}
+
+void UAdvCharacterMovementComponent::SimulateMovement(float DeltaTime)
+{
+	if (ProxyDetail == EAdvProxyDetail::Full)
+	{
+		Super::SimulateMovement(DeltaTime);
+		return;
+	}
+
+	// No physics and no custom modes, the capsule only moves with server updates and network smoothing hides the steps
+	// The replicated movement mode still has to be applied for animation
+	if (bNetworkUpdateReceived)
+	{
+		bNetworkUpdateReceived = false;
+		if (bNetworkMovementModeChanged)
+		{
+			ApplyNetworkMovementMode(CharacterOwner->GetReplicatedMovementMode());
+			bNetworkMovementModeChanged = false;
+		}
+	}
+}
+
+#pragma endregion Simulated Proxy Detail
+
 #pragma region Replication
 
+void FAdvProxyEventRing::Push(const FAdvProxyEvent& Event)
+{
+	Events[Head % Capacity] = Event;
+	Head++;
+}
+
+bool FAdvProxyEventRing::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	Ar << Head;
+
+	// Slots that were never written stay None and cost 2 bits
+	for (uint8 Slot = 0; Slot < Capacity; Slot++)
+	{
+		FAdvProxyEvent& Event = Events[Slot];
+
+		uint32 Type = static_cast<uint32>(Event.Type);
+		Ar.SerializeInt(Type, static_cast<uint32>(EAdvProxyEventType::Max));
+		Event.Type = static_cast<EAdvProxyEventType>(Type);
+		if (Event.Type == EAdvProxyEventType::None) continue;
+
+		if (Event.Type == EAdvProxyEventType::Mantle)
+		{
+			uint32 HeightClass = static_cast<uint32>(Event.HeightClass);
+			Ar.SerializeInt(HeightClass, static_cast<uint32>(EAdvLedgeClass::TallVault) + 1);
+			Event.HeightClass = static_cast<EAdvLedgeClass>(HeightClass);
+			bOutSuccess &= SerializePackedVector<1, 24>(Event.Target, Ar);
+		}
+		Ar << Event.ServerTime;
+	}
+
+	return !Ar.IsError();
+}
+
 void UAdvCharacterMovementComponent::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION(UAdvCharacterMovementComponent, Proxy_bDashStart, COND_SkipOwner)
-	DOREPLIFETIME_CONDITION(UAdvCharacterMovementComponent, Proxy_bShortMantle, COND_SkipOwner)
-	DOREPLIFETIME_CONDITION(UAdvCharacterMovementComponent, Proxy_bTallMantle, COND_SkipOwner)
-	DOREPLIFETIME_CONDITION(UAdvCharacterMovementComponent, Proxy_bShortVault, COND_SkipOwner)
-	DOREPLIFETIME_CONDITION(UAdvCharacterMovementComponent, Proxy_bTallVault, COND_SkipOwner)
+	// Push based, every change has to mark the property dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	Params.Condition = COND_SkipOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAdvCharacterMovementComponent, Proxy_Events, Params)
+	Params.Condition = COND_None;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAdvCharacterMovementComponent, MovementProfile, Params)
 }
 
-void UAdvCharacterMovementComponent::OnRep_DashStart()
+void UAdvCharacterMovementComponent::SetMovementProfile(UAdvMovementProfile* NewProfile)
 {
-	CharacterOwner->PlayAnimMontage(Dash_Montage);
-	DashStartDelegate.Broadcast();
+	if (MovementProfile == NewProfile) return;
+
+	MovementProfile = NewProfile;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAdvCharacterMovementComponent, MovementProfile, this);
+	Profile = ResolveMovementProfile();
 }
 
-void UAdvCharacterMovementComponent::OnRep_ShortMantle()
+UAdvMovementProfile* UAdvCharacterMovementComponent::ResolveMovementProfile() const
 {
-	CharacterOwner->PlayAnimMontage(Mantle_ProxyShortClimbMontage);
+	UAdvMovementProfile* Resolved = MovementProfile ? MovementProfile : GetMutableDefault<UAdvMovementProfile>();
+	Resolved->ConditionalBake();
+	return Resolved;
 }
 
-void UAdvCharacterMovementComponent::OnRep_TallMantle()
+void UAdvCharacterMovementComponent::OnRep_MovementProfile()
 {
-	CharacterOwner->PlayAnimMontage(Mantle_ProxyTallClimbMontage);
+	Profile = ResolveMovementProfile();
 }
 
-void UAdvCharacterMovementComponent::OnRep_ShortVault()
+void UAdvCharacterMovementComponent::PushProxyEvent(EAdvProxyEventType Type, EAdvLedgeClass HeightClass, const FVector& Target)
 {
-	
+	FAdvProxyEvent Event;
+	Event.Type = Type;
+	Event.HeightClass = HeightClass;
+	Event.Target = Target;
+	Event.ServerTime = GetWorld()->GetTimeSeconds();
+	Proxy_Events.Push(Event);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAdvCharacterMovementComponent, Proxy_Events, this);
 }
 
-void UAdvCharacterMovementComponent::OnRep_TallVault()
+void UAdvCharacterMovementComponent::PlayProxyEvent(const FAdvProxyEvent& Event)
 {
-	
+	UAnimMontage* Montage = nullptr;
+	switch (Event.Type)
+	{
+	case EAdvProxyEventType::Dash:
+		Montage = GetMontage(EAdvMontage::Dash);
+		DashStartDelegate.Broadcast();
+		break;
+	case EAdvProxyEventType::Mantle:
+		switch (Event.HeightClass)
+		{
+		case EAdvLedgeClass::ShortMantle:	Montage = GetMontage(EAdvMontage::ProxyShortClimb); break;
+		case EAdvLedgeClass::TallMantle:	Montage = GetMontage(EAdvMontage::ProxyTallClimb); break;
+		case EAdvLedgeClass::ShortVault:	Montage = GetMontage(EAdvMontage::ProxyShortVault); break;
+		case EAdvLedgeClass::TallVault:		Montage = GetMontage(EAdvMontage::ProxyTallVault); break;
+		}
+		POINT(Mantle, Event.Target, FColor::Purple)
+		break;
+	default:
+		break;
+	}
+
+	UAnimInstance* AnimInstance = CharacterOwner->GetMesh() ? CharacterOwner->GetMesh()->GetAnimInstance() : nullptr;
+	if (!Montage || !AnimInstance) return;
+
+	// Events that arrive late start part way through, ones that would already be over are skipped
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float Elapsed = GameState ? static_cast<float>(FMath::Max(GameState->GetServerWorldTimeSeconds() - Event.ServerTime, 0.0)) : 0.0f;
+	if (Elapsed >= Montage->GetPlayLength()) return;
+
+	AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, Elapsed);
+}
+
+void UAdvCharacterMovementComponent::OnRep_ProxyEvents()
+{
+	// Whatever is still in the ring when the proxy becomes relevant is played too, finished montages are skipped by the elapsed time
+	if (!bProxyEventsReceived)
+	{
+		Proxy_NextEvent = Proxy_Events.Head - FAdvProxyEventRing::Capacity;
+		bProxyEventsReceived = true;
+	}
+
+	const uint8 NumNew = Proxy_Events.Head - Proxy_NextEvent;
+	if (NumNew > FAdvProxyEventRing::Capacity)
+	{
+		ADV_LOG_RATELIMITED(LogAdvMovement, Verbose, 1.0, TEXT("%s missed %d proxy events"), *GetNameSafe(CharacterOwner), NumNew - FAdvProxyEventRing::Capacity)
+		Proxy_NextEvent = Proxy_Events.Head - FAdvProxyEventRing::Capacity;
+	}
+
+	for (; Proxy_NextEvent != Proxy_Events.Head; Proxy_NextEvent++)
+	{
+		const FAdvProxyEvent& Event = Proxy_Events.Get(Proxy_NextEvent);
+		if (Event.Type != EAdvProxyEventType::None)
+		{
+			PlayProxyEvent(Event);
+		}
+	}
 }
 
 #pragma endregion Replication
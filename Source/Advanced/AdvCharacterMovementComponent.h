@@ -1,13 +1,25 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "AdvancedCharacter.h"
+#include "AdvCorrectionTelemetry.h"
+#include "AdvLedgeData.h"
+#include "AdvMontageSet.h"
+#include "AdvMovementProfile.h"
+#include "Components/SkinnedMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "WorldCollision.h"
 #include "AdvCharacterMovementComponent.generated.h"
 
+struct FAdvGrabPoint;
+struct FAdvMoveRecording;
+struct FAdvRecordedMove;
+
 /// 1. You can alter movement safe variables in non-movement safe functions on the client
 /// 2. You can never utilise non-movement safe variables in a movement safe function
 /// 3. You can't call non-movement safe functions that alter movement safe variables on the server
 
+DECLARE_LOG_CATEGORY_EXTERN(LogAdvMovement, Log, All);
+
 // @todo look into delegates
 // An event that you can create and broadcast (A signal?)
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDashStartDelegate);
@@ -24,46 +36,200 @@ enum ECustomMovementMode
 	CMOVE_Max		UMETA(Hidden),
 };
 
+UENUM(BlueprintType)
+enum class EAdvTransitionKind : uint8
+{
+	None,
+	Mantle,
+	Hang,
+	Swing,
+};
+
+/// How much of the movement a simulated proxy runs, picked from its significance to the local views
+UENUM()
+enum class EAdvProxyDetail : uint8
+{
+	// Full physics including the custom modes
+	Full,
+	// Only follows server updates through network smoothing at a reduced tick rate
+	Reduced,
+	// Same as Reduced at a lower rate, animation only ticks montages while not rendered
+	Minimal,
+};
+
+/// Everything needed to drive a root motion transition into a mantle, hang or swing
+USTRUCT()
+struct FAdvTransition
+{
+	GENERATED_BODY()
+
+	UPROPERTY() EAdvTransitionKind Kind = EAdvTransitionKind::None;
+	// Only used by mantles
+	UPROPERTY() EAdvLedgeClass HeightClass = EAdvLedgeClass::ShortMantle;
+	UPROPERTY() FVector TargetLocation = FVector::ZeroVector;
+	UPROPERTY() FQuat TargetRotation = FQuat::Identity;
+	UPROPERTY() float Duration = 0.0f;
+	// Played once the transition reaches its target
+	UPROPERTY() TObjectPtr<UAnimMontage> QueuedMontage = nullptr;
+	UPROPERTY() float QueuedMontageSpeed = 0.0f;
+};
+
+UENUM()
+enum class EAdvProxyEventType : uint8
+{
+	None,
+	Dash,
+	// Mantles and vaults, told apart by the height class
+	Mantle,
+	Max UMETA(Hidden),
+};
+
+/// A cosmetic traversal event the server sends to simulated proxies
+USTRUCT()
+struct FAdvProxyEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY() EAdvProxyEventType Type = EAdvProxyEventType::None;
+	UPROPERTY() EAdvLedgeClass HeightClass = EAdvLedgeClass::ShortMantle;
+	// Transition target, only sent for mantles and quantized to 1cm
+	UPROPERTY() FVector Target = FVector::ZeroVector;
+	// Server world time the event happened at, late proxies start the montage this far in
+	UPROPERTY() float ServerTime = 0.0f;
+};
+
+/// The last few proxy events, replaces one toggled bool per event
+/// Events are numbered so proxies play every event they have not seen yet even if several happen between net updates
+USTRUCT()
+struct FAdvProxyEventRing
+{
+	GENERATED_BODY()
+
+	// Has to divide 256 so event numbers keep their slot when Head wraps
+	static constexpr uint8 Capacity = 4;
+
+	// Event N is in Events[N % Capacity]
+	FAdvProxyEvent Events[Capacity];
+	// Number of the next event, wraps around
+	uint8 Head = 0;
+
+	void Push(const FAdvProxyEvent& Event);
+	const FAdvProxyEvent& Get(uint8 Number) const { return Events[Number % Capacity]; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+	// Head changes with every event, nothing else has to be compared
+	bool operator==(const FAdvProxyEventRing& Other) const { return Head == Other.Head; }
+};
+
+template<>
+struct TStructOpsTypeTraits<FAdvProxyEventRing> : public TStructOpsTypeTraitsBase2<FAdvProxyEventRing>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 UCLASS()
 class ADVANCED_API UAdvCharacterMovementComponent : public UCharacterMovementComponent
 {
 	GENERATED_BODY()
 
+	// Bakes ledges with the same tuning TryMantle uses
+	friend struct FAdvLedgeBakeSettings;
+	// Ranks characters by their movement state and hands out probe intervals
+	friend class UAdvTraversalBudgetSubsystem;
+
+	// The wall being run on kept as a plane so substeps don't trace against the same wall again
+	// Saved with the moves so replays answer from the same plane the original move did
+	struct FWallRunContact
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		FVector Point = FVector::ZeroVector;
+		FVector Normal = FVector::ZeroVector;
+		// Where the plane is trusted, around the last traced hit
+		FBox Region = FBox(ForceInit);
+		float TimeRemaining = 0.0f;
+	};
+
 	/// Our version for saving a move allowing us to save custom data
 	/// Supports server authoritative behaviour
 	class FSavedMove_Adv : public FSavedMove_Character
 	{
 	public:
-		enum CompressedFlags
-		{
-			FLAG_Sprint		= 0x10,
-			FLAG_Dash		= 0x20,
-			FLAG_Custom_1	= 0x40,
-			FLAG_Custom_2	= 0x80,
-		};
-		
 		typedef FSavedMove_Character Super;
 
-		// FLAGS
+		// Inputs, sent to the server through FAdvNetworkMoveData
 		uint8 Saved_bWantsToSprint : 1;
 		uint8 Saved_bWantsToDash : 1;
 		uint8 Saved_bPressedAdvanceJump : 1;
+		uint8 Saved_bWantsToProne : 1;
 
-		// Non-Flags
+		// State
 		uint8 Saved_bPrevWantsToCrouch : 1;
-		uint8 Saved_bWantsToProne : 1;
 		uint8 Saved_bHadAnimRootMotion : 1;
 		uint8 Saved_bTransitionFinished : 1;
 		uint8 Saved_bWallRunIsRight : 1;
 		uint8 Saved_bCanClimbAgain : 1;
+		// Capsule the move started with, the slide crouches it without bWantsToCrouch
+		uint8 Saved_bIsCrouched : 1;
+		// Probe results the move used, recorded after it ran
+		uint8 Saved_TraversalProbeMask;
+		float Saved_TraversalProbeAccumulator;
+		FAdvTransition Saved_Transition;
+		FWallRunContact Saved_WallRunContact;
+		uint16 Saved_TransitionRMS_ID;
 		
 		FSavedMove_Adv();
 		
 		virtual bool CanCombineWith(const FSavedMovePtr& newMove, ACharacter* InCharacter, float MaxDelta) const override;
 		virtual void Clear() override;
-		virtual uint8 GetCompressedFlags() const override;
 		virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
 		virtual void PrepMoveFor(ACharacter* C) override;
+		virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override;
+		virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+
+		/// FAdvNetworkMoveData::EMoveFlags
+		uint32 GetAdvFlags() const;
+	};
+
+	/// Advanced movement inputs and state sent with every move, the engine's compressed flags only carry jump and crouch
+	/// Packed into a variable length mask so new modes only cost bandwidth when their bits are set
+	/// The pending and old move in a ServerMove are sent as a single bit when they match the new move
+	struct FAdvNetworkMoveData : public FCharacterNetworkMoveData
+	{
+		typedef FCharacterNetworkMoveData Super;
+
+		// Ordered by how often they are set, the first 7 bits fit in a single byte
+		enum EMoveFlags : uint32
+		{
+			// Inputs, applied by the server
+			MOVEFLAG_Sprint				= 1 << 0,
+			MOVEFLAG_Dash				= 1 << 1,
+			MOVEFLAG_AdvancedJump		= 1 << 2,
+			MOVEFLAG_Prone				= 1 << 3,
+			// State, the server runs its own and only checks it against these
+			MOVEFLAG_PrevWantsToCrouch	= 1 << 4,
+			MOVEFLAG_WallRunIsRight		= 1 << 5,
+			MOVEFLAG_CanClimbAgain		= 1 << 6,
+			MOVEFLAG_HadAnimRootMotion	= 1 << 7,
+			MOVEFLAG_TransitionFinished	= 1 << 8,
+
+			MOVEFLAG_State = MOVEFLAG_PrevWantsToCrouch | MOVEFLAG_WallRunIsRight | MOVEFLAG_CanClimbAgain | MOVEFLAG_HadAnimRootMotion | MOVEFLAG_TransitionFinished,
+		};
+
+		uint32 AdvFlags = 0;
+
+		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+	};
+
+	struct FAdvNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+	{
+		FAdvNetworkMoveDataContainer();
+
+		FAdvNetworkMoveData AdvMoveData[3];
 	};
 
 	/// Refines Network Prediction to allow for our custom FSavedMove_Adv
@@ -80,118 +246,100 @@ class ADVANCED_API UAdvCharacterMovementComponent : public UCharacterMovementCom
 	UPROPERTY(EditDefaultsOnly) bool Setting_GravityEnabledDash = true;
 	UPROPERTY(EditDefaultsOnly) float Sprint_MaxSpeed = 750.0f;
 	
-	UPROPERTY(EditDefaultsOnly) float Slide_MaxSpeed = 750.0f;
-	UPROPERTY(EditDefaultsOnly) float Slide_MinEnterSpeed = 600.0f;
-	UPROPERTY(EditDefaultsOnly) float Slide_MinExitSpeed = 200.0f;
-	UPROPERTY(EditDefaultsOnly) float Slide_EnterImpulse = 400.0f;
-	UPROPERTY(EditDefaultsOnly) float Slide_GravityForce = 4000.0f;
-	UPROPERTY(EditDefaultsOnly) UCurveFloat* Slide_FrictionCurveFactor;
-	UPROPERTY(EditDefaultsOnly) float Slide_MaxBrakingDeceleration = 1000.0f;
-	
 	UPROPERTY(EditDefaultsOnly) float Dash_Impulse = 1000.0f;
 	UPROPERTY(EditDefaultsOnly) float Dash_CooldownDuration = 1.0f;
 	// Prevents cheating by making sure cooldown is not half for example it's dash time allowing for a margin of
 	// error of 0.1f since DeltaTime is actually not perfectly synced on the client and server
 	UPROPERTY(EditDefaultsOnly) float Dash_AuthCooldownDuration = 0.9f;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Dash_Montage;
-
-	UPROPERTY(EditDefaultsOnly) float Mantle_MaxDistance = 200;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinDepth = 30;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinWallSteepnessAngle = 75;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MaxSurfaceAngle = 40;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MaxAlignmentAngle = 45;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinTransitionTime = 0.1;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MaxTransitionTime = 0.25;
-
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinShortVaultHeight = 60.f;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinTallVaultHeight = 110.f;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MaxVaultHeight = 150.f;
-
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinShortClimbHeight = 60.f;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MinTallClimbHeight = 180.f;
-	UPROPERTY(EditDefaultsOnly) float Mantle_MaxClimbHeight = 230.f;
-	
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_TallClimbMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_TransitionTallClimbMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_ProxyTallClimbMontage;
-	
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_ShortClimbMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_TransitionShortClimbMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_ProxyShortClimbMontage;
-	
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_TallVaultMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_TransitionTallVaultMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_ProxyTallVaultMontage;
-
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_ShortVaultMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_TransitionShortVaultMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Mantle_ProxyShortVaultMontage;
-
-	UPROPERTY(EditDefaultsOnly) float WallRun_MinSpeed = 200.f;
-	UPROPERTY(EditDefaultsOnly) float WallRun_MaxSpeed = 800.f;
-	UPROPERTY(EditDefaultsOnly) float WallRun_MaxVerticalSpeed = 200.f;
-	UPROPERTY(EditDefaultsOnly) float WallRun_PullAwayAngle = 75;
-	UPROPERTY(EditDefaultsOnly) float WallRun_AttractionForce = 200.f;
-	UPROPERTY(EditDefaultsOnly) float WallRun_MinHeight = 50.f;
-	UPROPERTY(EditDefaultsOnly) UCurveFloat* WallRun_GravityScaleCurve;
-	UPROPERTY(EditDefaultsOnly) float WallRun_JumpOffForce = 300.f;
-
-	UPROPERTY(EditDefaultsOnly) float Hang_MinTransitionTime = 0.1;
-	UPROPERTY(EditDefaultsOnly) float Hang_MaxTransitionTime = 0.25;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Hang_TransitionMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Hang_WallJumpMontage;
-	UPROPERTY(EditDefaultsOnly) float Hang_WallJumpForce = 400.f;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Swing_TransitionMontage;
-	UPROPERTY(EditDefaultsOnly) UAnimMontage* Swing_Montage;
-
-	UPROPERTY(EditDefaultsOnly) float Climb_MaxSpeed = 300.f;
-	UPROPERTY(EditDefaultsOnly) float Climb_BrakingDeceleration = 1000.f;
-	UPROPERTY(EditDefaultsOnly) float Climb_ReachDistance = 50.f;
-	UPROPERTY(EditDefaultsOnly) float Climb_MaxDuration = 3.f;
-	UPROPERTY(EditDefaultsOnly) float Climb_MantleCheckInterval = 0.5f;
-	UPROPERTY(EditDefaultsOnly) float Climb_GravityScaleCurve = 0.4f;
-	UPROPERTY(EditDefaultsOnly) float Climb_MaxDownwardVelocity = -300.f;
+	// Every montage the movement plays, streamed in instead of loading with the character
+	UPROPERTY(EditDefaultsOnly) UAdvMontageSet* MontageSet;
+	// Slide, mantle, wall run, hang and climb tuning, the class defaults of UAdvMovementProfile when not set
+	UPROPERTY(EditDefaultsOnly, ReplicatedUsing=OnRep_MovementProfile) UAdvMovementProfile* MovementProfile;
+
+	// Submits coarse async queries at the end of each move and reads them at the start of the next one
+	// The synchronous Try* functions are only run when their probe found something
+	UPROPERTY(EditDefaultsOnly) bool Setting_AsyncTraversalProbes = false;
+	// Server only, characters nobody plays run the scene queries their next move is expected to make ahead of it
+	// in one parallel batch with every other such character (see UAdvParallelMovementSubsystem)
+	UPROPERTY(EditDefaultsOnly) bool Setting_ParallelPrefetch = false;
+	// Move time one step of TraversalProbeInterval stands for, should match the server tick rate
+	UPROPERTY(EditDefaultsOnly) float Budget_ProbeFrameTime = 1.0f / 60.0f;
+
+	// How often the client sends moves per custom mode, moves in between are combined where possible
+	// Only ever slows the engine's ClientNetSendMoveDeltaTime down, 0 keeps it
+	UPROPERTY(EditDefaultsOnly) float Net_SlideSendDeltaTime = 0.0f;
+	UPROPERTY(EditDefaultsOnly) float Net_WallRunSendDeltaTime = 1.0f / 30.0f;
+	UPROPERTY(EditDefaultsOnly) float Net_HangSendDeltaTime = 1.0f / 10.0f;
+	UPROPERTY(EditDefaultsOnly) float Net_ClimbSendDeltaTime = 1.0f / 30.0f;
+
+	// Simulated proxies further away than this or off screen stop simulating and only interpolate
+	UPROPERTY(EditDefaultsOnly) float Proxy_FullDetailDistance = 2500.0f;
+	// Proxies further away than this drop to minimal detail
+	UPROPERTY(EditDefaultsOnly) float Proxy_ReducedDetailDistance = 6000.0f;
+	UPROPERTY(EditDefaultsOnly) float Proxy_ReducedTickInterval = 1.0f / 30.0f;
+	UPROPERTY(EditDefaultsOnly) float Proxy_MinimalTickInterval = 1.0f / 10.0f;
 	
 	// Transient
 	UPROPERTY(Transient) AAdvancedCharacter* AdvancedCharacterOwner;
+	// MovementProfile or the defaults, baked
+	const UAdvMovementProfile* Profile = nullptr;
 
-	// Flags
+	// Inputs
 	bool Safe_bWantsToSprint;
 	bool Safe_bWantsToProne;
 	bool Safe_bWantsToDash;
 
-	// Non-Flags
+	// State
 	bool Safe_bPrevWantsToCrouch;
 	bool Safe_bHadAnimRootMotion;
 	bool Safe_bWallRunIsRight;
 	bool Safe_bCanClimbAgain;
+	uint8 Safe_TraversalProbeMask;
+	// Move time since the last passive probe, saved so replays probe on the same moves
+	float Safe_TraversalProbeAccumulator;
+	bool Safe_bTraversalProbeDue;
 	
 	bool Safe_bTransitionFinished;
+	UPROPERTY(Transient) FAdvTransition Transition;
+	// Reused between transitions while nothing else references it
 	TSharedPtr<FRootMotionSource_MoveToForce> TransitionRMS;
-	FString TransitionName;
-	UPROPERTY(Transient) UAnimMontage* TransitionQueuedMontage;
-	float TransitionQueuedMontageSpeed;
-	int TransitionRMS_ID;
+	uint16 TransitionRMS_ID;
 	
 	float DashStartTime;
 	FTimerHandle TimerHandle_DashCooldown;
 	
 	// Replication
-	UPROPERTY(ReplicatedUsing=OnRep_DashStart) bool Proxy_bDashStart;
+	UPROPERTY(ReplicatedUsing=OnRep_ProxyEvents) FAdvProxyEventRing Proxy_Events;
+	// Number of the next event this proxy has to play
+	uint8 Proxy_NextEvent = 0;
+	bool bProxyEventsReceived = false;
 
-	UPROPERTY(ReplicatedUsing=OnRep_ShortMantle) bool Proxy_bShortMantle;
-	UPROPERTY(ReplicatedUsing=OnRep_TallMantle) bool Proxy_bTallMantle;
-	UPROPERTY(ReplicatedUsing=OnRep_ShortVault) bool Proxy_bShortVault;
-	UPROPERTY(ReplicatedUsing=OnRep_TallVault) bool Proxy_bTallVault;
+	// Passive probes run once every TraversalProbeInterval * Budget_ProbeFrameTime of move time, set by UAdvTraversalBudgetSubsystem
+	// Server only and always 1 for player characters, the client predicting them could not know when it changes
+	uint8 TraversalProbeInterval = 1;
 
 	// UnSafe because I just don't understand it
 	bool UnSafe_bWantsToSlide;
 	float ClimbMantleCheckAccumulator = 0.0f;
+
+	// Part of the scene a traversal query covers. Static is what PrefetchMoveQueries takes ahead of the move, Live is the rest
+	enum class EQueryScene : uint8
+	{
+		All,
+		Static,
+		Live,
+	};
+	// Splits the scene by mobility, static primitives are the ones the baked ledges and the prefetch can take as never moving
+	static EQueryMobilityType GetSceneMobility(EQueryScene Scene) { return Scene == EQueryScene::Static ? EQueryMobilityType::Static : Scene == EQueryScene::Live ? EQueryMobilityType::Dynamic : EQueryMobilityType::Any; }
+	// A BlockAll profile line trace limited to Scene
+	bool LineTraceScene(FHitResult& OutHit, const FVector& Start, const FVector& End, EQueryScene Scene) const;
 	
 public:
 	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual bool IsMovingOnGround() const override;
 	virtual bool CanCrouchInCurrentState() const override;
+	virtual void UnCrouch(bool bClientSimulation = false) override;
 	virtual float GetMaxSpeed() const override;
 	virtual float GetMaxBrakingDeceleration() const override;
 	virtual bool CanAttemptJump() const override;
@@ -206,9 +354,12 @@ private:
 	bool CanEnterSlide() const;
 	bool ShouldExitSlide() const;
 
-	// NOTE: THESE ARE NOT SIMULATED ON PROXIES
+	// Crouch the capsule like Crouch/UnCrouch without bWantsToCrouch, predicted through bIsCrouched which also replicates it to proxies
 	void HandleCustomCrouch();
 	void HandleCustomUnCrouch();
+	void SetCharacterCrouched(bool bCrouched);
+	// Resizes the capsule in place to the crouch state a replayed move started with
+	void RestoreCrouchedCapsule(bool bCrouched);
 
 public:
 	void ExitSlideMode();
@@ -222,37 +373,159 @@ private:
 	// Mantle
 	bool bShouldVaultHang;
 	bool TryMantle();
-	FVector GetMantleStartLocation(const FHitResult& FrontHit, const FHitResult& SurfaceHit, const bool bTallMantle, const std::string& Type) const;
-	void SetMantleMontages(const std::string& Type, const bool bTallMantle);
+	// Bottom of the capsule and the forward cast TryMantle looks for a ledge with
+	void GetMantleProbe(FVector& OutBaseLoc, FVector& OutFwd, float& OutCheckDistance) const;
+	// Baked ledges are only used by a character with the capsule and tuning they were baked for, crouched or scaled ones trace
+	FAdvLedgeBakeKey GetLedgeBakeKey() const { return FAdvLedgeBakeKey::Make(CapR(), CapHH(), *Profile); }
+	bool FindBakedMantleLedge(const FAdvLedgeBakeKey& BakeKey, const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, FHitResult& FrontHit, FHitResult& SurfaceHit, float& Height, bool& bShouldVault);
+	// LiveFrontHit is set when every level has ledges baked for this character and the live front traces already ran
+	bool TraceMantleLedge(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, const FHitResult* LiveFrontHit, FHitResult& FrontHit, FHitResult& SurfaceHit, float& Height, bool& bShouldVault);
+	// The front traces rise until one hits, at most MaxTraces of them. Returns the index of the one that hit or INDEX_NONE
+	static constexpr int32 MantleFrontTraces = 6;
+	int32 TraceMantleFront(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, EQueryScene Scene, int32 MaxTraces, FHitResult& OutFrontHit) const;
+	FVector GetMantleStartLocation(const FHitResult& FrontHit, const FHitResult& SurfaceHit, EAdvLedgeClass HeightClass) const;
+	void SetMantleMontages(EAdvLedgeClass HeightClass);
+
+	// Transition
+	void StartTransition(const FAdvTransition& NewTransition);
 	
 	// Wall Run
+	FWallRunContact WallRunContact;
 	bool TryWallRun();
 	void PhysWallRun(float deltaTime, int32 Iterations);
+	// bAllowContact answers from WallRunContact when the cast crosses it, otherwise the cast is traced and the contact refreshed
+	bool FindWallRunWall(const FVector& Start, const FVector& End, FVector& OutNormal, bool bAllowContact = true);
+	void CacheWallRunContact(const FHitResult& WallHit);
 
 	// Hang
 	bool TryHang();
+	// At the head of the capsule two radii in front, where grab points are searched around
+	FVector GetHangSearchCenter() const { return UpdatedComponent->GetComponentLocation() + FVector::UpVector * CapHH() + UpdatedComponent->GetForwardVector() * CapR() * 3; }
+	// Grab point TryHang goes for and where the capsule hangs from it
+	const FAdvGrabPoint* FindHangTarget(const FVector& SearchCenter, FVector& OutLocation, FQuat& OutRotation) const;
+	bool SweepHangReach(const FVector& Start, const FVector& End, EQueryScene Scene, FHitResult& OutHit) const;
 
 	// Climb
 	bool TryClimb();
 	void PhysClimb(float deltaTime, int32 Iterations);
 	float ClimbTimeRemaining = 0.0f; // Maybe save this as well?
+
+	// Async Traversal Probes
+	// Each bit says the matching Try* is worth running this move
+	enum ETraversalProbe : uint8
+	{
+		PROBE_Mantle	= 0x01,
+		PROBE_Climb		= 0x02,
+		PROBE_WallRun	= 0x04,
+		PROBE_All		= PROBE_Mantle | PROBE_Climb | PROBE_WallRun,
+		// Run every falling move without any input, these are what the budget throttles
+		PROBE_Passive	= PROBE_Climb | PROBE_WallRun,
+	};
+	FTraceHandle Probe_FrontHandle;
+	FTraceHandle Probe_WallHandle;
+	FTraceHandle Probe_FloorHandle;
+	void SubmitTraversalProbes(float DeltaSeconds);
+	void ConsumeTraversalProbes();
+	bool CanTryTraversal(ETraversalProbe Probe) const;
+	void UpdateTraversalProbeSchedule(float DeltaSeconds);
+	bool IsTraversalProbeDueNextMove(float DeltaSeconds) const;
+	void SetTraversalProbeInterval(int32 Interval, int32 Phase);
+
+	// Network Move Data
+	FAdvNetworkMoveDataContainer AdvNetworkMoveDataContainer;
+	// Sent state the server disagrees with, only logged and counted
+	void CheckClientMoveState(uint32 ClientFlags) const;
+	// Bucket corrections are recorded under by FAdvCorrectionTelemetry
+	EAdvCorrectionCategory GetCorrectionCategory() const;
+
+	// Move Recording
+	TSharedPtr<FAdvMoveRecording> MoveRecording;
+	void RecordMove(const FSavedMove_Character& Move);
+
+	// Simulated Proxy Detail
+	EAdvProxyDetail ProxyDetail = EAdvProxyDetail::Full;
+	bool bProxySignificanceRegistered = false;
+	// What the mesh was set up with, restored when leaving minimal detail
+	EVisibilityBasedAnimTickOption ProxyAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	float GetProxySignificance(const FTransform& Viewpoint) const;
+	void SetProxyDetail(EAdvProxyDetail NewDetail);
+	void UpdateProxyWallRunSide();
 	
 	// Helpers / Other
 	bool IsServer() const;
-	float CapR() const;
-	float CapHH() const;
-	std::string LastMontage = "NA";
+	// Scaled size of the capsule as it is now, from the character's cached dimensions
+	float CapR() const { return AdvancedCharacterOwner->GetDimensions().Radius; }
+	float CapHH() const { return AdvancedCharacterOwner->GetDimensions().HalfHeight; }
+	UAnimMontage* GetMontage(EAdvMontage Montage) const;
+	/// True when something blocks the line from the capsule center straight down within Distance
+	/// Answered from CurrentFloor on walkable ground, otherwise from one trace per location and frame shared by every caller
+	/// The prefetch asks for the Static scene only, the first caller of the move then traces the rest
+	bool IsGroundWithin(float Distance, EQueryScene Scene = EQueryScene::All) const;
+	struct FGroundProbe
+	{
+		FVector Location = FVector::ZeroVector;
+		uint64 Frame = 0;
+		float TraceDistance = 0.0f;
+		// BIG_NUMBER when nothing was hit within TraceDistance
+		float HitDistance = BIG_NUMBER;
+		// Prefetched, the first caller of the move adds what isn't static geometry
+		bool bStaticOnly = false;
+	};
+	mutable FGroundProbe GroundProbe;
+	void TraceGroundProbe(const FVector& Location, float Distance, EQueryScene Scene) const;
+	// Queries a move takes from PrefetchMoveQueries when the start and end match, one slot per call site
+	// Only static geometry is prefetched since it can't have moved before the move runs, the rest is still queried by the move
+	enum EPrefetchTrace : uint8
+	{
+		PREFETCH_ClimbReach,
+		PREFETCH_WallRunLeft,
+		PREFETCH_WallRunRight,
+		PREFETCH_MantleFront,
+		PREFETCH_HangReach,
+		PREFETCH_Max,
+	};
+	struct FPrefetchedTrace
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		uint64 Frame = 0;
+		FHitResult Hit;
+		// Mantle front only, which of the rising traces hit
+		int32 HitIndex = INDEX_NONE;
+	};
+	mutable FPrefetchedTrace PrefetchedTraces[PREFETCH_Max];
+	FPrefetchedTrace& StartPrefetch(EPrefetchTrace Trace, const FVector& Start, const FVector& End) const;
+	void PrefetchTrace(EPrefetchTrace Trace, const FVector& Start, const FVector& End) const;
+	const FPrefetchedTrace* FindPrefetchedTrace(EPrefetchTrace Trace, const FVector& Start, const FVector& End) const;
+	bool GetPrefetchedTrace(EPrefetchTrace Trace, const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+	bool bParallelPrefetchRegistered = false;
+public:
+	/// Runs the static geometry part of the scene queries the coming move is expected to make from where the character is now and keeps them for it
+	/// Only writes the probe caches, so UAdvParallelMovementSubsystem can run it for many characters at once
+	/// Passive probes are only prefetched when the move of DeltaSeconds is due to run them
+	void PrefetchMoveQueries(float DeltaSeconds) const;
+private:
+	// Mantle montage OnMontageEnded is waiting for
+	TOptional<EAdvLedgeClass> LastMantleClass;
 	UFUNCTION() void OnMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+
 	
 protected:
 	virtual void InitializeComponent() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
 	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
 	virtual void UpdateCharacterStateAfterMovement(float DeltaSeconds) override;
 	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+	virtual void SimulateMovement(float DeltaTime) override;
+	virtual float GetClientNetSendDeltaTime(const APlayerController* PC, const FNetworkPredictionData_Client_Character* ClientData, const FSavedMovePtr& NewMove) const override;
+	virtual void CallServerMovePacked(const FSavedMove_Character* NewMove, const FSavedMove_Character* PendingMove, const FSavedMove_Character* OldMove) override;
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+	virtual void OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, FVector ServerGravityDirection) override;
 	
 	/// Custom blueprint export functions
 public:
@@ -277,14 +550,25 @@ public:
 
 	UFUNCTION(BlueprintPure) bool IsHanging() const { return IsCustomMovementMode(CMOVE_Hang); }
 	UFUNCTION(BlueprintPure) bool IsClimbing() const { return IsCustomMovementMode(CMOVE_Climb); }
+
+	/// Records every move this client sends to the server until StopMoveRecording
+	void StartMoveRecording();
+	TSharedPtr<FAdvMoveRecording> StopMoveRecording();
+	/// Runs a recorded move the way the server runs a move it receives, without time stamp checks or corrections
+	void ReplayRecordedMove(const FAdvRecordedMove& Move);
+
+	/// Swaps the tuning of this character, call on the server and the owning client and proxies follow through replication
+	void SetMovementProfile(UAdvMovementProfile* NewProfile);
+	/// MovementProfile or the UAdvMovementProfile defaults, baked and ready to read from
+	UAdvMovementProfile* ResolveMovementProfile() const;
 	
 	// Can move replication to the base character to save bandwidth
 public:
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 private:
-	UFUNCTION() void OnRep_DashStart();
-	UFUNCTION() void OnRep_ShortMantle();
-	UFUNCTION() void OnRep_TallMantle();
-	UFUNCTION() void OnRep_ShortVault();
-	UFUNCTION() void OnRep_TallVault();
+	// Server only
+	void PushProxyEvent(EAdvProxyEventType Type, EAdvLedgeClass HeightClass = EAdvLedgeClass::ShortMantle, const FVector& Target = FVector::ZeroVector);
+	void PlayProxyEvent(const FAdvProxyEvent& Event);
+	UFUNCTION() void OnRep_ProxyEvents();
+	UFUNCTION() void OnRep_MovementProfile();
 };
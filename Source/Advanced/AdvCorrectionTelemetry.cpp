@@ -0,0 +1,137 @@
+#include "AdvCorrectionTelemetry.h"
+
+#if ADV_ENABLE_MOVEMENT_STATS
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvCorrections, Log, All);
+
+CSV_DEFINE_CATEGORY(AdvCorrections, true);
+
+#pragma region Recording
+
+#if CSV_PROFILER
+// Indexed by side then category, the CSV profiler keeps the pointers
+static const char* CsvCorrectionNames[2][static_cast<int32>(EAdvCorrectionCategory::Max)] =
+{
+	{ "Server_Default", "Server_Slide", "Server_WallRun", "Server_Hang", "Server_Climb", "Server_Dash", "Server_Mantle" },
+	{ "Client_Default", "Client_Slide", "Client_WallRun", "Client_Hang", "Client_Climb", "Client_Dash", "Client_Mantle" },
+};
+#endif
+
+template<int32 NumBuckets>
+static int32 GetBucket(const float (&Bounds)[NumBuckets], float Value)
+{
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		if (Value < Bounds[Bucket]) return Bucket;
+	}
+	return NumBuckets;
+}
+
+void FAdvCorrectionTelemetry::Record(ESide Side, EAdvCorrectionCategory Category, float Distance, float VelocityError, bool bModeMismatch)
+{
+	FCategory& Stats = Categories[static_cast<int32>(Side)][static_cast<int32>(Category)];
+	Stats.Count++;
+	Stats.ModeMismatches += bModeMismatch ? 1 : 0;
+	Stats.DistanceSum += Distance;
+	Stats.MaxDistance = FMath::Max(Stats.MaxDistance, Distance);
+	Stats.VelocityErrorSum += VelocityError;
+	Stats.DistanceHistogram[GetBucket(DistanceBuckets, Distance)]++;
+	Stats.VelocityHistogram[GetBucket(VelocityBuckets, VelocityError)]++;
+
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(CsvCorrectionNames[static_cast<int32>(Side)][static_cast<int32>(Category)], CSV_CATEGORY_INDEX(AdvCorrections), 1, ECsvCustomStatOp::Accumulate);
+#endif
+}
+
+void FAdvCorrectionTelemetry::Reset()
+{
+	for (FCategory (&SideCategories)[static_cast<int32>(EAdvCorrectionCategory::Max)] : Categories)
+	{
+		for (FCategory& Stats : SideCategories)
+		{
+			Stats = FCategory();
+		}
+	}
+}
+
+const TCHAR* FAdvCorrectionTelemetry::GetCategoryName(EAdvCorrectionCategory Category)
+{
+	switch (Category)
+	{
+	case EAdvCorrectionCategory::Default:	return TEXT("Default");
+	case EAdvCorrectionCategory::Slide:		return TEXT("Slide");
+	case EAdvCorrectionCategory::WallRun:	return TEXT("WallRun");
+	case EAdvCorrectionCategory::Hang:		return TEXT("Hang");
+	case EAdvCorrectionCategory::Climb:		return TEXT("Climb");
+	case EAdvCorrectionCategory::Dash:		return TEXT("Dash");
+	case EAdvCorrectionCategory::Mantle:	return TEXT("Mantle");
+	default:								return TEXT("Invalid");
+	}
+}
+
+#pragma endregion Recording
+
+#pragma region Export
+
+FString FAdvCorrectionTelemetry::ToCsv()
+{
+	FString Csv = TEXT("Side,Category,Count,ModeMismatches,AvgDistance,MaxDistance,AvgVelocityError");
+	for (int32 Bucket = 0; Bucket < NumDistanceBuckets; Bucket++)
+	{
+		Csv += Bucket < NumDistanceBuckets - 1 ? FString::Printf(TEXT(",Distance<%g"), DistanceBuckets[Bucket]) : FString::Printf(TEXT(",Distance>=%g"), DistanceBuckets[Bucket - 1]);
+	}
+	for (int32 Bucket = 0; Bucket < NumVelocityBuckets; Bucket++)
+	{
+		Csv += Bucket < NumVelocityBuckets - 1 ? FString::Printf(TEXT(",VelocityError<%g"), VelocityBuckets[Bucket]) : FString::Printf(TEXT(",VelocityError>=%g"), VelocityBuckets[Bucket - 1]);
+	}
+	Csv += TEXT("\n");
+
+	for (int32 Side = 0; Side < 2; Side++)
+	{
+		for (int32 Category = 0; Category < static_cast<int32>(EAdvCorrectionCategory::Max); Category++)
+		{
+			const FCategory& Stats = Categories[Side][Category];
+			const double Count = FMath::Max<double>(Stats.Count, 1.0);
+			Csv += FString::Printf(TEXT("%s,%s,%u,%u,%.2f,%.2f,%.2f"),
+				Side == static_cast<int32>(ESide::Server) ? TEXT("Server") : TEXT("Client"), GetCategoryName(static_cast<EAdvCorrectionCategory>(Category)),
+				Stats.Count, Stats.ModeMismatches, Stats.DistanceSum / Count, Stats.MaxDistance, Stats.VelocityErrorSum / Count);
+			for (uint32 BucketCount : Stats.DistanceHistogram) Csv += FString::Printf(TEXT(",%u"), BucketCount);
+			for (uint32 BucketCount : Stats.VelocityHistogram) Csv += FString::Printf(TEXT(",%u"), BucketCount);
+			Csv += TEXT("\n");
+		}
+	}
+	return Csv;
+}
+
+static FAutoConsoleCommand CmdAdvCorrectionsDump(TEXT("adv.Corrections.Dump"), TEXT("Logs the net corrections recorded per movement mode"), FConsoleCommandDelegate::CreateLambda([]()
+{
+	UE_LOG(LogAdvCorrections, Display, TEXT("\n%s"), *FAdvCorrectionTelemetry::ToCsv());
+}));
+
+static FAutoConsoleCommand CmdAdvCorrectionsExport(TEXT("adv.Corrections.Export"), TEXT("Writes the net corrections recorded per movement mode to a csv file, Saved/Profiling/AdvCorrections_<Time>.csv unless a path is given"), FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	const FString OutputPath = Args.Num() > 0 ? Args[0] : FPaths::ProfilingDir() / FString::Printf(TEXT("AdvCorrections_%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(FAdvCorrectionTelemetry::ToCsv(), *OutputPath))
+	{
+		UE_LOG(LogAdvCorrections, Display, TEXT("Saved corrections to %s"), *OutputPath);
+	}
+	else
+	{
+		UE_LOG(LogAdvCorrections, Error, TEXT("Failed to write %s"), *OutputPath);
+	}
+}));
+
+static FAutoConsoleCommand CmdAdvCorrectionsReset(TEXT("adv.Corrections.Reset"), TEXT("Clears the recorded net corrections"), FConsoleCommandDelegate::CreateLambda([]()
+{
+	FAdvCorrectionTelemetry::Reset();
+}));
+
+#pragma endregion Export
+
+#endif
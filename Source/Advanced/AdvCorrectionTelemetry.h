@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdvMovementStats.h"
+
+/// What the character was doing when a correction happened, custom modes first then the transitions
+enum class EAdvCorrectionCategory : uint8
+{
+	// Walking, falling and every other engine mode
+	Default,
+	Slide,
+	WallRun,
+	Hang,
+	Climb,
+	// Within the dash cooldown after a dash
+	Dash,
+	// A mantle or vault transition was running
+	Mantle,
+	Max,
+};
+
+#if ADV_ENABLE_MOVEMENT_STATS
+
+/// Counts net corrections per category on both ends of the connection
+/// Server: every move ServerCheckClientError rejects, Client: every correction OnClientCorrectionReceived applies
+/// A listen server or PIE records both sides in the same process
+/// adv.Corrections.Dump logs the table, adv.Corrections.Export [File] writes it as csv, adv.Corrections.Reset clears it
+/// With a CSV profiler capture running every correction is also recorded in the AdvCorrections category
+struct FAdvCorrectionTelemetry
+{
+	enum class ESide : uint8
+	{
+		Server,
+		Client,
+	};
+
+	// Upper bounds of the histogram buckets, the last bucket takes everything above
+	static constexpr float DistanceBuckets[] = { 1.0f, 5.0f, 10.0f, 25.0f, 50.0f, 100.0f };
+	static constexpr float VelocityBuckets[] = { 10.0f, 50.0f, 100.0f, 250.0f, 500.0f, 1000.0f };
+	static constexpr int32 NumDistanceBuckets = UE_ARRAY_COUNT(DistanceBuckets) + 1;
+	static constexpr int32 NumVelocityBuckets = UE_ARRAY_COUNT(VelocityBuckets) + 1;
+
+	struct FCategory
+	{
+		uint32 Count = 0;
+		uint32 ModeMismatches = 0;
+		double DistanceSum = 0.0;
+		float MaxDistance = 0.0f;
+		double VelocityErrorSum = 0.0;
+		uint32 DistanceHistogram[NumDistanceBuckets] = {};
+		uint32 VelocityHistogram[NumVelocityBuckets] = {};
+	};
+
+	/// Game thread only, the server has no client velocity to compare so its VelocityError is always 0
+	static void Record(ESide Side, EAdvCorrectionCategory Category, float Distance, float VelocityError, bool bModeMismatch);
+	static void Reset();
+	static FString ToCsv();
+	static const TCHAR* GetCategoryName(EAdvCorrectionCategory Category);
+
+private:
+	static inline FCategory Categories[2][static_cast<int32>(EAdvCorrectionCategory::Max)];
+};
+
+#endif
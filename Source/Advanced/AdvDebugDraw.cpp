@@ -0,0 +1,154 @@
+#include "AdvDebugDraw.h"
+
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#pragma region Console Variables
+
+#if ADV_ENABLE_DEBUG_DRAW
+static TAutoConsoleVariable<bool> CVarAdvDebugMovement(TEXT("adv.Debug.Movement"), false, TEXT("Draw general movement state changes and transitions"));
+static TAutoConsoleVariable<bool> CVarAdvDebugMantle(TEXT("adv.Debug.Mantle"), false, TEXT("Draw mantle and vault probes"));
+static TAutoConsoleVariable<bool> CVarAdvDebugWallRun(TEXT("adv.Debug.WallRun"), false, TEXT("Draw wall run probes"));
+static TAutoConsoleVariable<bool> CVarAdvDebugHang(TEXT("adv.Debug.Hang"), false, TEXT("Draw hang and climb probes"));
+static TAutoConsoleVariable<bool> CVarAdvDebugSlide(TEXT("adv.Debug.Slide"), false, TEXT("Draw slide state changes"));
+static TAutoConsoleVariable<float> CVarAdvDebugDuration(TEXT("adv.Debug.Duration"), 2.0f, TEXT("How long debug draws and messages stay on screen, 0 draws for a single frame"));
+
+static bool IsFeatureEnabled(EAdvDebugFeature Feature)
+{
+	switch (Feature)
+	{
+	case EAdvDebugFeature::Movement:
+		return CVarAdvDebugMovement.GetValueOnGameThread();
+	case EAdvDebugFeature::Mantle:
+		return CVarAdvDebugMantle.GetValueOnGameThread();
+	case EAdvDebugFeature::WallRun:
+		return CVarAdvDebugWallRun.GetValueOnGameThread();
+	case EAdvDebugFeature::Hang:
+		return CVarAdvDebugHang.GetValueOnGameThread();
+	case EAdvDebugFeature::Slide:
+		return CVarAdvDebugSlide.GetValueOnGameThread();
+	default:
+		return false;
+	}
+}
+#endif
+
+#pragma endregion Console Variables
+
+#pragma region Recording
+
+UAdvDebugDrawSubsystem* UAdvDebugDrawSubsystem::GetIfEnabled(const UWorld* World, EAdvDebugFeature Feature)
+{
+#if ADV_ENABLE_DEBUG_DRAW
+	// Checked first since it is by far the most common outcome
+	if (!IsFeatureEnabled(Feature) || !World || World->GetNetMode() == NM_DedicatedServer) return nullptr;
+	return World->GetSubsystem<UAdvDebugDrawSubsystem>();
+#else
+	return nullptr;
+#endif
+}
+
+void UAdvDebugDrawSubsystem::AddMessage(const FString& Message)
+{
+	Messages.Add(Message);
+}
+
+void UAdvDebugDrawSubsystem::AddPoint(const FVector& Location, const FColor& Color)
+{
+	Points.Add({ Location, Color });
+}
+
+void UAdvDebugDrawSubsystem::AddLine(const FVector& Start, const FVector& End, const FColor& Color)
+{
+	Lines.Add({ Start, End, Color });
+}
+
+void UAdvDebugDrawSubsystem::AddCapsule(const FVector& Center, float HalfHeight, float Radius, const FColor& Color)
+{
+	Capsules.Add({ Center, FQuat::Identity, FVector(HalfHeight, Radius, 0.0f), Color });
+}
+
+void UAdvDebugDrawSubsystem::AddBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent, const FColor& Color)
+{
+	Boxes.Add({ Center, Rotation, HalfExtent, Color });
+}
+
+void UAdvDebugDrawSubsystem::AddSphere(const FVector& Center, float Radius, const FColor& Color)
+{
+	Spheres.Add({ Center, FQuat::Identity, FVector(Radius, 0.0f, 0.0f), Color });
+}
+
+#pragma endregion Recording
+
+#pragma region Subsystem
+
+bool UAdvDebugDrawSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if ADV_ENABLE_DEBUG_DRAW
+	return Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+void UAdvDebugDrawSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Flush();
+}
+
+TStatId UAdvDebugDrawSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAdvDebugDrawSubsystem, STATGROUP_Tickables);
+}
+
+void UAdvDebugDrawSubsystem::Flush()
+{
+#if ADV_ENABLE_DEBUG_DRAW
+	const UWorld* World = GetWorld();
+	const float Duration = CVarAdvDebugDuration.GetValueOnGameThread();
+	// A zero duration means the draw only lives for this frame
+	const bool bPersistent = false;
+	const float LifeTime = Duration > 0.0f ? Duration : -1.0f;
+
+	for (const FDebugLine& Line : Lines)
+	{
+		DrawDebugLine(World, Line.Start, Line.End, Line.Color, bPersistent, LifeTime);
+	}
+	for (const FDebugPoint& Point : Points)
+	{
+		DrawDebugPoint(World, Point.Location, 10, Point.Color, bPersistent, LifeTime);
+	}
+	for (const FDebugShape& Capsule : Capsules)
+	{
+		DrawDebugCapsule(World, Capsule.Center, Capsule.Extent.X, Capsule.Extent.Y, Capsule.Rotation, Capsule.Color, bPersistent, LifeTime);
+	}
+	for (const FDebugShape& Box : Boxes)
+	{
+		DrawDebugBox(World, Box.Center, Box.Extent, Box.Rotation, Box.Color, bPersistent, LifeTime);
+	}
+	for (const FDebugShape& Sphere : Spheres)
+	{
+		DrawDebugSphere(World, Sphere.Center, Sphere.Extent.X, 32, Sphere.Color, bPersistent, LifeTime);
+	}
+	if (GEngine)
+	{
+		for (const FString& Message : Messages)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, Duration > 0.0f ? Duration : 0.0f, FColor::Yellow, Message);
+		}
+	}
+#endif
+
+	// Reset keeps the allocations around for the next frame
+	Lines.Reset();
+	Points.Reset();
+	Capsules.Reset();
+	Boxes.Reset();
+	Spheres.Reset();
+	Messages.Reset();
+}
+
+#pragma endregion Subsystem
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include <atomic>
+
+#include "AdvDebugDraw.generated.h"
+
+/// Debug visualisation only exists in builds that can draw, so Shipping and dedicated Server targets compile it out
+#define ADV_ENABLE_DEBUG_DRAW (ENABLE_DRAW_DEBUG && !UE_SERVER)
+
+/// Logs at most once every IntervalSeconds per call site, use this for logs that sit on the movement hot path
+/// Safe from any thread, only the caller that swaps the timestamp logs
+#define ADV_LOG_RATELIMITED(CategoryName, Verbosity, IntervalSeconds, Format, ...) \
+	{ \
+		static std::atomic<double> AdvLastLogTime{-DBL_MAX}; \
+		const double AdvLogNow = FPlatformTime::Seconds(); \
+		double AdvLogLast = AdvLastLogTime.load(std::memory_order_relaxed); \
+		if (AdvLogNow - AdvLogLast >= (IntervalSeconds) && AdvLastLogTime.compare_exchange_strong(AdvLogLast, AdvLogNow, std::memory_order_relaxed)) \
+		{ \
+			UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+		} \
+	}
+
+/// Each feature has its own console variable (adv.Debug.<Feature>)
+enum class EAdvDebugFeature : uint8
+{
+	Movement,
+	Mantle,
+	WallRun,
+	Hang,
+	Slide,
+};
+
+/// Collects debug draws and on screen messages during the frame and flushes them once on tick
+/// Nothing is recorded unless the console variable for the feature is enabled
+UCLASS()
+class ADVANCED_API UAdvDebugDrawSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FDebugLine
+	{
+		FVector Start;
+		FVector End;
+		FColor Color;
+	};
+
+	struct FDebugPoint
+	{
+		FVector Location;
+		FColor Color;
+	};
+
+	struct FDebugShape
+	{
+		FVector Center;
+		FQuat Rotation;
+		// Capsule: X = HalfHeight, Y = Radius | Box: half extent | Sphere: X = Radius
+		FVector Extent;
+		FColor Color;
+	};
+
+	TArray<FDebugLine> Lines;
+	TArray<FDebugPoint> Points;
+	TArray<FDebugShape> Capsules;
+	TArray<FDebugShape> Boxes;
+	TArray<FDebugShape> Spheres;
+	TArray<FString> Messages;
+
+public:
+	/// Returns the subsystem only if the feature is enabled, so callers skip building draw arguments otherwise
+	static UAdvDebugDrawSubsystem* GetIfEnabled(const UWorld* World, EAdvDebugFeature Feature);
+
+	void AddMessage(const FString& Message);
+	void AddPoint(const FVector& Location, const FColor& Color);
+	void AddLine(const FVector& Start, const FVector& End, const FColor& Color);
+	void AddCapsule(const FVector& Center, float HalfHeight, float Radius, const FColor& Color);
+	void AddBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent, const FColor& Color);
+	void AddSphere(const FVector& Center, float Radius, const FColor& Color);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void Flush();
+};
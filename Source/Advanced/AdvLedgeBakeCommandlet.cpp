@@ -0,0 +1,476 @@
+#include "AdvLedgeBakeCommandlet.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvLedgeData.h"
+#include "AdvTraversalSubsystem.h"
+#include "AdvancedCharacter.h"
+#include "ClimbPointComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvLedgeBake, Log, All);
+
+UAdvLedgeBakeCommandlet::UAdvLedgeBakeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+#if WITH_EDITOR
+
+#pragma region Settings
+
+// Everything the bake needs from the character it is baking for
+struct FAdvLedgeBakeSettings
+{
+	float Spacing = 25.0f;
+	float CapR = 0.0f;
+	float CapHH = 0.0f;
+	float MinHeight = 0.0f;
+	float MaxHeight = 0.0f;
+	float MinTallClimbHeight = 0.0f;
+	float MinTallVaultHeight = 0.0f;
+	float MaxVaultHeight = 0.0f;
+	float CosMinWallSteepness = 0.0f;
+	float CosMaxSurfaceAngle = 0.0f;
+	FAdvLedgeBakeKey Key;
+
+	bool Read(const TMap<FString, FString>& ParamValues);
+};
+
+bool FAdvLedgeBakeSettings::Read(const TMap<FString, FString>& ParamValues)
+{
+	UClass* CharacterClass = AAdvancedCharacter::StaticClass();
+	if (const FString* CharacterPath = ParamValues.Find(TEXT("Character")))
+	{
+		CharacterClass = LoadClass<AAdvancedCharacter>(nullptr, **CharacterPath);
+		if (!CharacterClass)
+		{
+			UE_LOG(LogAdvLedgeBake, Error, TEXT("Could not load character class %s"), **CharacterPath);
+			return false;
+		}
+	}
+
+	const AAdvancedCharacter* Character = CharacterClass->GetDefaultObject<AAdvancedCharacter>();
+	const UAdvCharacterMovementComponent* Movement = Character->GetAdvancedCharacterMovementComponent();
+	if (!Movement)
+	{
+		UE_LOG(LogAdvLedgeBake, Error, TEXT("%s has no advanced movement component"), *CharacterClass->GetName());
+		return false;
+	}
+
+	if (const FString* SpacingValue = ParamValues.Find(TEXT("Spacing")))
+	{
+		Spacing = FMath::Max(FCString::Atof(**SpacingValue), 5.0f);
+	}
+	CapR = Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	CapHH = Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	// Same window TryMantle searches in
+	const UAdvMovementProfile* Profile = Movement->ResolveMovementProfile();
+	MinHeight = Profile->Mantle_MinShortClimbHeight - 1;
+	MaxHeight = Profile->Mantle_MaxClimbHeight;
+	MinTallClimbHeight = Profile->Mantle_MinTallClimbHeight;
+	MinTallVaultHeight = Profile->Mantle_MinTallVaultHeight;
+	MaxVaultHeight = Profile->Mantle_MaxVaultHeight;
+	CosMinWallSteepness = Profile->Mantle_CosMinWallSteepnessAngle;
+	CosMaxSurfaceAngle = Profile->Mantle_CosMaxSurfaceAngle;
+	Key = FAdvLedgeBakeKey::Make(CapR, CapHH, *Profile);
+	return true;
+}
+
+#pragma endregion Settings
+
+#pragma region Sampling
+
+// Grab points are handled by TryHang and are never mantled
+static bool IsGrabPointActor(const AActor* Actor)
+{
+	return Actor->ActorHasTag(UAdvTraversalSubsystem::ClimbPointTag) || Actor->ActorHasTag(UAdvTraversalSubsystem::SwingPointTag) || Actor->FindComponentByClass<UClimbPointComponent>();
+}
+
+// The same profile TryMantle traces, limited to static primitives by BakeMap's params. TryMantle still traces everything else
+static const FName BakeProfile = "BlockAll";
+static constexpr int32 MaxColumnSurfaces = 8;
+
+// Every surface under one column, highest first
+using FAdvLedgeColumn = TArray<FHitResult, TInlineAllocator<4>>;
+
+static void TraceColumn(const UWorld* World, const FVector& Top, float BottomZ, const FCollisionQueryParams& Params, FAdvLedgeColumn& Column)
+{
+	FCollisionQueryParams ColumnParams = Params;
+	FVector Start = Top;
+	const FVector End(Top.X, Top.Y, BottomZ);
+	FHitResult Hit;
+	while (Column.Num() < MaxColumnSurfaces && Start.Z > BottomZ && World->LineTraceSingleByProfile(Hit, Start, End, BakeProfile, ColumnParams))
+	{
+		// Restarted inside something, skip past it
+		if (Hit.bStartPenetrating)
+		{
+			ColumnParams.AddIgnoredComponent(Hit.GetComponent());
+			continue;
+		}
+		Column.Add(Hit);
+		Start.Z = Hit.Location.Z - 1.0f;
+	}
+}
+
+// Finds the floor a character would be standing on next to Surface, nullptr if this isn't a ledge
+static const FHitResult* FindLedgeFloor(const FHitResult& Surface, const FAdvLedgeColumn& Neighbour, const FAdvLedgeBakeSettings& Settings)
+{
+	for (const FHitResult& Below : Neighbour)
+	{
+		const float Drop = Surface.Location.Z - Below.Location.Z;
+		// Anything between the floor and head height above the ledge means there is no wall face to mantle
+		if (Drop < Settings.MinHeight)
+		{
+			if (Drop > -2.0f * Settings.CapHH) return nullptr;
+			continue;
+		}
+		if (Drop > Settings.MaxHeight || Below.ImpactNormal.Z < Settings.CosMaxSurfaceAngle) return nullptr;
+		return &Below;
+	}
+	return nullptr;
+}
+
+// Mirrors the front, surface, clearance and vault checks of TryMantle for a character standing on Floor
+static bool SampleLedge(const UWorld* World, const FCollisionQueryParams& Params, const FVector& WallColumn, const FVector& FloorColumn, const FHitResult& Surface, const FHitResult& Floor, const FAdvLedgeBakeSettings& Settings, FAdvLedgeSegment& OutLedge)
+{
+	const FVector Up = FVector::UpVector;
+	const float Height = Surface.Location.Z - Floor.Location.Z;
+
+	// ---- FRONT ---- //
+	// Just under the lip so the face found is the one the surface belongs to
+	const float FaceZ = Surface.Location.Z - FMath::Min(10.0f, Height * 0.5f);
+	const FVector FrontStart(FloorColumn.X, FloorColumn.Y, FaceZ);
+	const FVector FrontEnd(WallColumn.X, WallColumn.Y, FaceZ);
+	FHitResult FrontHit;
+	if (!World->LineTraceSingleByProfile(FrontHit, FrontStart, FrontEnd, BakeProfile, Params) || FrontHit.bStartPenetrating) return false;
+	if (FMath::Abs(FrontHit.ImpactNormal | Up) > Settings.CosMinWallSteepness) return false;
+	const FVector WallNormal = FrontHit.ImpactNormal.GetSafeNormal2D();
+
+	// ---- SURFACE ---- //
+	const FVector SurfaceStart = FrontHit.Location - WallNormal * 3 + Up * (Surface.Location.Z + 2.0f * Settings.CapHH - FrontHit.Location.Z);
+	FHitResult SurfaceHit;
+	if (!World->LineTraceSingleByProfile(SurfaceHit, SurfaceStart, FrontHit.Location - WallNormal * 3, BakeProfile, Params) || SurfaceHit.bStartPenetrating) return false;
+	if ((SurfaceHit.ImpactNormal | Up) < Settings.CosMaxSurfaceAngle) return false;
+
+	OutLedge.Start = OutLedge.End = FVector(FrontHit.Location.X, FrontHit.Location.Y, SurfaceHit.Location.Z);
+	OutLedge.WallNormal = WallNormal;
+	OutLedge.SurfaceNormal = SurfaceHit.ImpactNormal;
+	OutLedge.FloorZ = Floor.Location.Z;
+
+	// ---- CLEARANCE ---- //
+	const float MaxClearance = 4.0f * Settings.CapHH;
+	const FVector ClearStart = SurfaceHit.Location - WallNormal * Settings.CapR + Up * (Settings.CapR + 1);
+	FHitResult ClearHit;
+	if (!World->SweepSingleByProfile(ClearHit, ClearStart, ClearStart + Up * MaxClearance, FQuat::Identity, BakeProfile, FCollisionShape::MakeSphere(Settings.CapR), Params))
+	{
+		OutLedge.Clearance = MaxClearance + Settings.CapR * 2 + 1;
+	}
+	else
+	{
+		OutLedge.Clearance = ClearHit.bStartPenetrating ? 0.0f : ClearHit.Distance + Settings.CapR * 2 + 1;
+	}
+
+	// ---- VAULT ---- //
+	// Same trace as TryMantle with the character standing on the floor
+	const FCollisionShape CapShape = FCollisionShape::MakeCapsule(Settings.CapR, Settings.CapHH);
+	FVector VaultStart = FrontHit.Location - WallNormal * Settings.CapR * 2;
+	VaultStart.Z = Floor.Location.Z + Settings.CapHH * 1.5f;
+	const FVector VaultEnd = VaultStart + FVector::DownVector * Settings.CapHH * 2.5f;
+	FHitResult VaultHit;
+	if (World->LineTraceSingleByProfile(VaultHit, VaultStart, VaultEnd, BakeProfile, Params))
+	{
+		OutLedge.VaultFloorZ = VaultHit.Location.Z;
+		OutLedge.bVaultable = !VaultHit.bStartPenetrating && !World->OverlapAnyTestByProfile(VaultHit.Location + Up * (Settings.CapHH + 2), FQuat::Identity, BakeProfile, CapShape, Params);
+	}
+	else
+	{
+		OutLedge.VaultFloorZ = -UE_OLD_WORLD_MAX;
+		OutLedge.bVaultable = !World->OverlapAnyTestByProfile(VaultEnd, FQuat::Identity, BakeProfile, CapShape, Params);
+	}
+
+	const bool bVault = OutLedge.bVaultable && Height < Settings.MaxVaultHeight;
+	if (bVault)
+	{
+		OutLedge.HeightClass = Height > Settings.MinTallVaultHeight ? EAdvLedgeClass::TallVault : EAdvLedgeClass::ShortVault;
+	}
+	else
+	{
+		OutLedge.HeightClass = Height > Settings.MinTallClimbHeight ? EAdvLedgeClass::TallMantle : EAdvLedgeClass::ShortMantle;
+	}
+	return true;
+}
+
+#pragma endregion Sampling
+
+#pragma region Segments
+
+// Samples with the same key lie on the same straight ledge and only need sorting along it
+struct FAdvLedgeSample
+{
+	FAdvLedgeSegment Ledge;
+	int32 Yaw;
+	int32 Offset;
+	int32 Height;
+	int32 Type;
+	float Along;
+};
+
+static void AddSample(TArray<FAdvLedgeSample>& Samples, const FAdvLedgeSegment& Ledge)
+{
+	FAdvLedgeSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.Ledge = Ledge;
+	Sample.Yaw = FMath::RoundToInt(FMath::RadiansToDegrees(FMath::Atan2(Ledge.WallNormal.Y, Ledge.WallNormal.X)));
+	// Bucket along the rounded normal so every sample of a wall shares the same tangent
+	const float YawRadians = FMath::DegreesToRadians(static_cast<float>(Sample.Yaw));
+	const FVector2D Normal(FMath::Cos(YawRadians), FMath::Sin(YawRadians));
+	const FVector2D Location(Ledge.Start);
+	Sample.Offset = FMath::RoundToInt((Location | Normal) / 5.0f);
+	Sample.Height = FMath::RoundToInt(Ledge.Start.Z / 5.0f);
+	Sample.Type = static_cast<int32>(Ledge.HeightClass) << 1 | (Ledge.bVaultable ? 1 : 0);
+	Sample.Along = Location | FVector2D(-Normal.Y, Normal.X);
+}
+
+static TArray<FAdvLedgeSegment> MergeSamples(TArray<FAdvLedgeSample>& Samples, float Spacing)
+{
+	Samples.Sort([](const FAdvLedgeSample& A, const FAdvLedgeSample& B)
+	{
+		if (A.Yaw != B.Yaw) return A.Yaw < B.Yaw;
+		if (A.Offset != B.Offset) return A.Offset < B.Offset;
+		if (A.Height != B.Height) return A.Height < B.Height;
+		if (A.Type != B.Type) return A.Type < B.Type;
+		return A.Along < B.Along;
+	});
+
+	TArray<FAdvLedgeSegment> Segments;
+	const FAdvLedgeSample* Previous = nullptr;
+	for (const FAdvLedgeSample& Sample : Samples)
+	{
+		const bool bContinues = Previous
+			&& Previous->Yaw == Sample.Yaw && Previous->Offset == Sample.Offset && Previous->Height == Sample.Height && Previous->Type == Sample.Type
+			&& Sample.Along - Previous->Along <= Spacing * 1.5f;
+
+		if (!bContinues)
+		{
+			Segments.Add(Sample.Ledge);
+		}
+		else
+		{
+			// Keep the most restrictive values so a baked ledge never allows more than a trace would
+			FAdvLedgeSegment& Segment = Segments.Last();
+			Segment.End = Sample.Ledge.End;
+			Segment.FloorZ = FMath::Max(Segment.FloorZ, Sample.Ledge.FloorZ);
+			Segment.Clearance = FMath::Min(Segment.Clearance, Sample.Ledge.Clearance);
+			Segment.VaultFloorZ = FMath::Max(Segment.VaultFloorZ, Sample.Ledge.VaultFloorZ);
+		}
+		Previous = &Sample;
+	}
+	return Segments;
+}
+
+#pragma endregion Segments
+
+#pragma region Baking
+
+static bool SaveLedgeData(const ULevel* Level, TArray<FAdvLedgeSegment>&& Segments, const FAdvLedgeBakeSettings& Settings)
+{
+	const FString PackageName = UAdvLedgeData::GetPackageNameForLevel(Level);
+	const FString AssetName = FPackageName::GetShortName(PackageName);
+	UPackage* Package = CreatePackage(*PackageName);
+	Package->FullyLoad();
+
+	UAdvLedgeData* LedgeData = FindObject<UAdvLedgeData>(Package, *AssetName);
+	if (!LedgeData) LedgeData = NewObject<UAdvLedgeData>(Package, *AssetName, RF_Public | RF_Standalone);
+	LedgeData->Segments = MoveTemp(Segments);
+	LedgeData->BakeKey = Settings.Key;
+	Package->MarkPackageDirty();
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Package, LedgeData, *Filename, SaveArgs))
+	{
+		UE_LOG(LogAdvLedgeBake, Error, TEXT("Failed to save %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogAdvLedgeBake, Display, TEXT("Saved %d ledges to %s"), LedgeData->Segments.Num(), *PackageName);
+	return true;
+}
+
+static bool BakeLevel(const UWorld* World, const ULevel* Level, const FCollisionQueryParams& Params, const FAdvLedgeBakeSettings& Settings)
+{
+	FBox Bounds(ForceInit);
+	for (const AActor* Actor : Level->Actors)
+	{
+		if (!Actor || IsGrabPointActor(Actor)) continue;
+
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&Bounds](const UPrimitiveComponent* Primitive)
+		{
+			if (Primitive->IsQueryCollisionEnabled() && Primitive->Mobility == EComponentMobility::Static)
+			{
+				Bounds += Primitive->Bounds.GetBox();
+			}
+		});
+	}
+
+	TArray<FAdvLedgeSample> Samples;
+	if (Bounds.IsValid)
+	{
+		const float Spacing = Settings.Spacing;
+		const int32 NumX = FMath::CeilToInt(Bounds.GetSize().X / Spacing) + 1;
+		const int32 NumY = FMath::CeilToInt(Bounds.GetSize().Y / Spacing) + 1;
+		UE_LOG(LogAdvLedgeBake, Display, TEXT("Sampling %s with %d x %d columns"), *Level->GetOutermost()->GetName(), NumX, NumY);
+
+		auto GetColumnLocation = [&](int32 X, int32 Y)
+		{
+			return FVector(Bounds.Min.X + X * Spacing, Bounds.Min.Y + Y * Spacing, Bounds.Max.Z + 1.0f);
+		};
+
+		TArray<FAdvLedgeColumn> Columns;
+		Columns.SetNum(NumX * NumY);
+		for (int32 X = 0; X < NumX; X++)
+		{
+			for (int32 Y = 0; Y < NumY; Y++)
+			{
+				TraceColumn(World, GetColumnLocation(X, Y), Bounds.Min.Z - 1.0f, Params, Columns[X * NumY + Y]);
+			}
+		}
+
+		const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+		for (int32 X = 0; X < NumX; X++)
+		{
+			for (int32 Y = 0; Y < NumY; Y++)
+			{
+				for (const FHitResult& Surface : Columns[X * NumY + Y])
+				{
+					if (Surface.ImpactNormal.Z < Settings.CosMaxSurfaceAngle) continue;
+					// Geometry of other levels is only there for clearance
+					if (!Surface.GetComponent() || Surface.GetComponent()->GetComponentLevel() != Level) continue;
+
+					for (const FIntPoint& Offset : Offsets)
+					{
+						const int32 NX = X + Offset.X;
+						const int32 NY = Y + Offset.Y;
+						if (NX < 0 || NX >= NumX || NY < 0 || NY >= NumY) continue;
+
+						const FHitResult* Floor = FindLedgeFloor(Surface, Columns[NX * NumY + NY], Settings);
+						if (!Floor) continue;
+
+						FAdvLedgeSegment Ledge;
+						if (SampleLedge(World, Params, GetColumnLocation(X, Y), GetColumnLocation(NX, NY), Surface, *Floor, Settings, Ledge))
+						{
+							AddSample(Samples, Ledge);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return SaveLedgeData(Level, MergeSamples(Samples, Settings.Spacing), Settings);
+}
+
+static bool BakeMap(const FString& MapName, const FAdvLedgeBakeSettings& Settings)
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogAdvLedgeBake, Error, TEXT("Could not load map %s"), *MapName);
+		return false;
+	}
+
+	// Only collision is needed, nothing is ticked or rendered
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.SetTransactional(false));
+	}
+
+	for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+	{
+		StreamingLevel->SetShouldBeLoaded(true);
+		StreamingLevel->SetShouldBeVisible(true);
+	}
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+	World->UpdateWorldComponents(true, false);
+
+	if (World->IsPartitionedWorld())
+	{
+		UE_LOG(LogAdvLedgeBake, Warning, TEXT("%s uses world partition, only always loaded actors are baked"), *MapName);
+	}
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(AdvLedgeBake), false);
+	Params.MobilityType = EQueryMobilityType::Static;
+	for (const ULevel* Level : World->GetLevels())
+	{
+		for (const AActor* Actor : Level->Actors)
+		{
+			if (Actor && IsGrabPointActor(Actor)) Params.AddIgnoredActor(Actor);
+		}
+	}
+
+	bool bSuccess = true;
+	for (const ULevel* Level : World->GetLevels())
+	{
+		bSuccess &= BakeLevel(World, Level, Params, Settings);
+	}
+
+	World->CleanupWorld();
+	World->RemoveFromRoot();
+	CollectGarbage(RF_NoFlags);
+	return bSuccess;
+}
+
+#pragma endregion Baking
+
+#endif
+
+int32 UAdvLedgeBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<FString> Maps;
+	ParamValues.FindRef(TEXT("Map")).ParseIntoArray(Maps, TEXT(","));
+	if (Maps.IsEmpty())
+	{
+		UE_LOG(LogAdvLedgeBake, Error, TEXT("Usage: -run=AdvLedgeBake -Map=/Game/Maps/MapA,/Game/Maps/MapB [-Character=<Class Path>] [-Spacing=25]"));
+		return 1;
+	}
+
+	FAdvLedgeBakeSettings Settings;
+	if (!Settings.Read(ParamValues)) return 1;
+
+	int32 Failures = 0;
+	for (const FString& Map : Maps)
+	{
+		if (!BakeMap(Map, Settings)) Failures++;
+	}
+	return Failures == 0 ? 0 : 1;
+#else
+	UE_LOG(LogAdvLedgeBake, Error, TEXT("Ledges can only be baked from an editor build"));
+	return 1;
+#endif
+}
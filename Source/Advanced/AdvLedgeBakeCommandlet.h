@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AdvLedgeBakeCommandlet.generated.h"
+
+/// Scans the static geometry of each map and bakes its mantle and vault ledges into a UAdvLedgeData per level
+/// Runs headless so it can sit in the cook pipeline:
+/// UnrealEditor-Cmd Advanced.uproject -run=AdvLedgeBake -Map=/Game/Maps/MapA,/Game/Maps/MapB [-Character=/Game/BP_Character.BP_Character_C] [-Spacing=25] -unattended -nullrhi
+/// Only WorldStatic objects are baked, anything else is still traced at runtime
+/// Nothing references the baked assets so their folder has to be in DirectoriesToAlwaysCook
+UCLASS()
+class ADVANCED_API UAdvLedgeBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvLedgeBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,109 @@
+#include "AdvLedgeData.h"
+
+#include "AdvMovementProfile.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+FAdvLedgeBakeKey FAdvLedgeBakeKey::Make(float CapR, float CapHH, const UAdvMovementProfile& Profile)
+{
+	FAdvLedgeBakeKey Key;
+	Key.CapsuleRadius = CapR;
+	Key.CapsuleHalfHeight = CapHH;
+	for (const float Tuning : { Profile.Mantle_MinShortClimbHeight, Profile.Mantle_MaxClimbHeight, Profile.Mantle_MinTallClimbHeight, Profile.Mantle_MinTallVaultHeight,
+		Profile.Mantle_MaxVaultHeight, Profile.Mantle_CosMinWallSteepnessAngle, Profile.Mantle_CosMaxSurfaceAngle })
+	{
+		Key.TuningHash = HashCombineFast(Key.TuningHash, GetTypeHash(Tuning));
+	}
+	return Key;
+}
+
+bool FAdvLedgeBakeKey::Matches(const FAdvLedgeBakeKey& Other) const
+{
+	// Scaled capsules pick up float error, a tenth of a unit is well below the bake spacing
+	return TuningHash == Other.TuningHash && FMath::IsNearlyEqual(CapsuleRadius, Other.CapsuleRadius, 0.1f) && FMath::IsNearlyEqual(CapsuleHalfHeight, Other.CapsuleHalfHeight, 0.1f);
+}
+
+FString UAdvLedgeData::GetPackageNameForLevel(const ULevel* Level)
+{
+	return UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName()) + TEXT("_Ledges");
+}
+
+void UAdvLedgeData::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildCells();
+}
+
+FIntPoint UAdvLedgeData::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UAdvLedgeData::BuildCells()
+{
+	Cells.Reset();
+
+	for (int32 Index = 0; Index < Segments.Num(); Index++)
+	{
+		const FAdvLedgeSegment& Segment = Segments[Index];
+		const FIntPoint MinCell = GetCell(Segment.Start.ComponentMin(Segment.End));
+		const FIntPoint MaxCell = GetCell(Segment.Start.ComponentMax(Segment.End));
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+			}
+		}
+	}
+}
+
+const FAdvLedgeSegment* UAdvLedgeData::FindLedge(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, float MinHeight, float MaxHeight, float MaxFloorHeight, FVector& OutEdgePoint, float& OutDistance) const
+{
+	const FVector TraceEnd = BaseLoc + Fwd * CheckDistance;
+	const FIntPoint MinCell = GetCell(BaseLoc.ComponentMin(TraceEnd));
+	const FIntPoint MaxCell = GetCell(BaseLoc.ComponentMax(TraceEnd));
+
+	const FAdvLedgeSegment* Best = nullptr;
+	OutDistance = CheckDistance;
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+
+			for (const int32 Index : *Cell)
+			{
+				const FAdvLedgeSegment& Segment = Segments[Index];
+				if (&Segment == Best) continue;
+
+				// Has to be facing the wall
+				const FVector WallNormal = Segment.WallNormal.GetSafeNormal2D();
+				const float Facing = Fwd | WallNormal;
+				if (Facing >= 0.0f) continue;
+
+				// Where the forward trace would hit the wall plane
+				const float Distance = ((Segment.Start - BaseLoc) | WallNormal) / Facing;
+				if (Distance < 0.0f || Distance > OutDistance) continue;
+
+				const FVector Edge = Segment.End - Segment.Start;
+				const float EdgeLengthSquared = Edge.SizeSquared2D();
+				const float Alpha = EdgeLengthSquared > UE_KINDA_SMALL_NUMBER ? (FVector2D(BaseLoc + Fwd * Distance - Segment.Start) | FVector2D(Edge)) / EdgeLengthSquared : 0.0f;
+				// Segments are baked from samples a cell apart so allow a little overhang at the ends
+				const float Tolerance = EdgeLengthSquared > UE_KINDA_SMALL_NUMBER ? 10.0f / FMath::Sqrt(EdgeLengthSquared) : 1.0f;
+				if (Alpha < -Tolerance || Alpha > 1.0f + Tolerance) continue;
+
+				const FVector EdgePoint = Segment.Start + Edge * FMath::Clamp(Alpha, 0.0f, 1.0f);
+				const float Height = EdgePoint.Z - BaseLoc.Z;
+				if (Height < MinHeight || Height > MaxHeight || Segment.FloorZ - BaseLoc.Z > MaxFloorHeight) continue;
+
+				Best = &Segment;
+				OutEdgePoint = EdgePoint;
+				OutDistance = Distance;
+			}
+		}
+	}
+	return Best;
+}
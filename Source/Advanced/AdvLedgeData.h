@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AdvLedgeData.generated.h"
+
+class ULevel;
+class UAdvMovementProfile;
+
+UENUM(BlueprintType)
+enum class EAdvLedgeClass : uint8
+{
+	ShortMantle,
+	TallMantle,
+	ShortVault,
+	TallVault,
+};
+
+/// A straight run of ledge along the top edge of a static wall
+USTRUCT()
+struct FAdvLedgeSegment
+{
+	GENERATED_BODY()
+
+	// Top edge where the wall face meets the surface
+	UPROPERTY(VisibleAnywhere) FVector Start = FVector::ZeroVector;
+	UPROPERTY(VisibleAnywhere) FVector End = FVector::ZeroVector;
+	UPROPERTY(VisibleAnywhere) FVector WallNormal = FVector::ZeroVector;
+	UPROPERTY(VisibleAnywhere) FVector SurfaceNormal = FVector::UpVector;
+	// Height of the floor in front of the wall
+	UPROPERTY(VisibleAnywhere) float FloorZ = 0.0f;
+	// Free height above the surface, only the baking capsule radius was tested
+	UPROPERTY(VisibleAnywhere) float Clearance = 0.0f;
+	// Height of the floor behind the wall, -UE_OLD_WORLD_MAX when the far side drops away
+	UPROPERTY(VisibleAnywhere) float VaultFloorZ = -UE_OLD_WORLD_MAX;
+	// The baking capsule fit on the far side
+	UPROPERTY(VisibleAnywhere) bool bVaultable = false;
+	// Classified against the tuning of the baking character when standing on the floor in front
+	UPROPERTY(VisibleAnywhere) EAdvLedgeClass HeightClass = EAdvLedgeClass::ShortMantle;
+};
+
+/// Capsule and mantle tuning a level's ledges were baked for, characters that don't match trace instead
+USTRUCT()
+struct FAdvLedgeBakeKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere) float CapsuleRadius = 0.0f;
+	UPROPERTY(VisibleAnywhere) float CapsuleHalfHeight = 0.0f;
+	// Of the mantle heights and angles the bake classifies and rejects ledges with
+	UPROPERTY(VisibleAnywhere) uint32 TuningHash = 0;
+
+	static FAdvLedgeBakeKey Make(float CapR, float CapHH, const UAdvMovementProfile& Profile);
+	bool Matches(const FAdvLedgeBakeKey& Other) const;
+};
+
+/// Mantle and vault candidates baked from the static geometry of one level by UAdvLedgeBakeCommandlet
+/// Saved next to the level as <Level>_Ledges and loaded in the background by UAdvTraversalSubsystem when the level is added
+UCLASS()
+class ADVANCED_API UAdvLedgeData : public UDataAsset
+{
+	GENERATED_BODY()
+
+	// Cells only hold indices into Segments
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+public:
+	UPROPERTY(VisibleAnywhere) TArray<FAdvLedgeSegment> Segments;
+	UPROPERTY(VisibleAnywhere) float CellSize = 200.0f;
+	// Ledges baked before the key was saved match nothing
+	UPROPERTY(VisibleAnywhere) FAdvLedgeBakeKey BakeKey;
+
+	/// Where the ledges of a level are saved, PIE prefixes are stripped
+	static FString GetPackageNameForLevel(const ULevel* Level);
+
+	virtual void PostLoad() override;
+
+	void BuildCells();
+
+	/// Finds the closest ledge whose wall is hit tracing CheckDistance along Fwd from BaseLoc
+	/// Only ledges between MinHeight and MaxHeight above BaseLoc whose wall reaches down to MaxFloorHeight are considered
+	const FAdvLedgeSegment* FindLedge(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, float MinHeight, float MaxHeight, float MaxFloorHeight, FVector& OutEdgePoint, float& OutDistance) const;
+};
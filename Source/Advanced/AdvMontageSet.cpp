@@ -0,0 +1,96 @@
+#include "AdvMontageSet.h"
+
+#include "Animation/AnimMontage.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvMontages, Log, All);
+
+EAdvMontageGroup UAdvMontageSet::GetGroup(EAdvMontage Montage)
+{
+	switch (Montage)
+	{
+	case EAdvMontage::Dash:
+		return EAdvMontageGroup::Dash;
+	case EAdvMontage::ProxyTallClimb:
+	case EAdvMontage::ProxyShortClimb:
+	case EAdvMontage::ProxyTallVault:
+	case EAdvMontage::ProxyShortVault:
+		return EAdvMontageGroup::Proxy;
+	case EAdvMontage::HangTransition:
+	case EAdvMontage::HangWallJump:
+	case EAdvMontage::SwingTransition:
+	case EAdvMontage::Swing:
+		return EAdvMontageGroup::Hang;
+	default:
+		return EAdvMontageGroup::Mantle;
+	}
+}
+
+const TSoftObjectPtr<UAnimMontage>& UAdvMontageSet::GetSoftMontage(EAdvMontage Montage) const
+{
+	switch (Montage)
+	{
+	case EAdvMontage::Dash:					return Dash_Montage;
+	case EAdvMontage::TallClimb:			return Mantle_TallClimbMontage;
+	case EAdvMontage::TransitionTallClimb:	return Mantle_TransitionTallClimbMontage;
+	case EAdvMontage::ProxyTallClimb:		return Mantle_ProxyTallClimbMontage;
+	case EAdvMontage::ShortClimb:			return Mantle_ShortClimbMontage;
+	case EAdvMontage::TransitionShortClimb:	return Mantle_TransitionShortClimbMontage;
+	case EAdvMontage::ProxyShortClimb:		return Mantle_ProxyShortClimbMontage;
+	case EAdvMontage::TallVault:			return Mantle_TallVaultMontage;
+	case EAdvMontage::TransitionTallVault:	return Mantle_TransitionTallVaultMontage;
+	case EAdvMontage::ProxyTallVault:		return Mantle_ProxyTallVaultMontage;
+	case EAdvMontage::ShortVault:			return Mantle_ShortVaultMontage;
+	case EAdvMontage::TransitionShortVault:	return Mantle_TransitionShortVaultMontage;
+	case EAdvMontage::ProxyShortVault:		return Mantle_ProxyShortVaultMontage;
+	case EAdvMontage::HangTransition:		return Hang_TransitionMontage;
+	case EAdvMontage::HangWallJump:			return Hang_WallJumpMontage;
+	case EAdvMontage::SwingTransition:		return Swing_TransitionMontage;
+	default:								return Swing_Montage;
+	}
+}
+
+void UAdvMontageSet::Preload()
+{
+	for (EAdvMontageGroup Group : PreloadGroups)
+	{
+		RequestGroup(Group);
+	}
+}
+
+void UAdvMontageSet::RequestGroup(EAdvMontageGroup Group)
+{
+	if (Group == EAdvMontageGroup::Proxy && IsRunningDedicatedServer()) return;
+
+	TSharedPtr<FStreamableHandle>& Handle = Handles[static_cast<int32>(Group)];
+	if (Handle.IsValid()) return;
+
+	TArray<FSoftObjectPath> Paths;
+	for (int32 Index = 0; Index < static_cast<int32>(EAdvMontage::Max); Index++)
+	{
+		const EAdvMontage Montage = static_cast<EAdvMontage>(Index);
+		const TSoftObjectPtr<UAnimMontage>& SoftMontage = GetSoftMontage(Montage);
+		if (GetGroup(Montage) == Group && !SoftMontage.IsNull()) Paths.Add(SoftMontage.ToSoftObjectPath());
+	}
+	if (Paths.IsEmpty()) return;
+
+	// Holding the handle keeps the group resident
+	Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+}
+
+UAnimMontage* UAdvMontageSet::GetMontage(EAdvMontage Montage)
+{
+	const TSoftObjectPtr<UAnimMontage>& SoftMontage = GetSoftMontage(Montage);
+	if (SoftMontage.IsNull()) return nullptr;
+	if (UAnimMontage* Loaded = SoftMontage.Get()) return Loaded;
+
+	const EAdvMontageGroup Group = GetGroup(Montage);
+	RequestGroup(Group);
+	// Missing the first proxy montage beats a hitch
+	if (Group == EAdvMontageGroup::Proxy) return nullptr;
+
+	// Root motion and notifies of the others drive the move, and the client and server have to play them alike
+	UE_LOG(LogAdvMontages, Log, TEXT("%s was needed before it streamed in, loading it now (add its group to PreloadGroups of %s)"), *SoftMontage.ToString(), *GetName());
+	return SoftMontage.LoadSynchronous();
+}
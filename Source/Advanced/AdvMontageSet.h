@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AdvMontageSet.generated.h"
+
+class UAnimMontage;
+struct FStreamableHandle;
+
+/// Every montage UAdvCharacterMovementComponent plays
+UENUM()
+enum class EAdvMontage : uint8
+{
+	Dash,
+	TallClimb,
+	TransitionTallClimb,
+	ProxyTallClimb,
+	ShortClimb,
+	TransitionShortClimb,
+	ProxyShortClimb,
+	TallVault,
+	TransitionTallVault,
+	ProxyTallVault,
+	ShortVault,
+	TransitionShortVault,
+	ProxyShortVault,
+	HangTransition,
+	HangWallJump,
+	SwingTransition,
+	Swing,
+	Max UMETA(Hidden),
+};
+
+/// Montages are streamed in a group at a time
+UENUM()
+enum class EAdvMontageGroup : uint8
+{
+	Dash,
+	Mantle,
+	Hang,
+	// Only played on simulated proxies, dedicated servers never load them
+	Proxy,
+	Max UMETA(Hidden),
+};
+
+/// The traversal montages of a character, soft referenced so they don't load with the character class
+/// The groups in PreloadGroups start loading when the first character using the set is initialized,
+/// the rest when their mode is first used (see UAdvCharacterMovementComponent::OnMovementModeChanged)
+/// Loaded groups stay resident for as long as the set is, every character sharing the set shares the loads
+UCLASS()
+class ADVANCED_API UAdvMontageSet : public UDataAsset
+{
+	GENERATED_BODY()
+
+	TSharedPtr<FStreamableHandle> Handles[static_cast<int32>(EAdvMontageGroup::Max)];
+
+public:
+	UPROPERTY(EditDefaultsOnly) TSet<EAdvMontageGroup> PreloadGroups = { EAdvMontageGroup::Dash, EAdvMontageGroup::Mantle };
+
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Dash_Montage;
+
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_TallClimbMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_TransitionTallClimbMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_ProxyTallClimbMontage;
+
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_ShortClimbMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_TransitionShortClimbMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_ProxyShortClimbMontage;
+
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_TallVaultMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_TransitionTallVaultMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_ProxyTallVaultMontage;
+
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_ShortVaultMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_TransitionShortVaultMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Mantle_ProxyShortVaultMontage;
+
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Hang_TransitionMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Hang_WallJumpMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Swing_TransitionMontage;
+	UPROPERTY(EditDefaultsOnly) TSoftObjectPtr<UAnimMontage> Swing_Montage;
+
+	static EAdvMontageGroup GetGroup(EAdvMontage Montage);
+	const TSoftObjectPtr<UAnimMontage>& GetSoftMontage(EAdvMontage Montage) const;
+
+	/// Starts loading PreloadGroups, does nothing for groups already loading
+	void Preload();
+	/// Starts loading every montage of the group, does nothing when it already is
+	void RequestGroup(EAdvMontageGroup Group);
+	/// The montage if it is loaded, otherwise its group is requested
+	/// Proxy montages return null until they are streamed in, the others are loaded on the spot since the move can't wait for them
+	UAnimMontage* GetMontage(EAdvMontage Montage);
+};
@@ -0,0 +1,127 @@
+#include "AdvMoveRecording.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvancedCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvRecording, Log, All);
+
+#pragma region Serialization
+
+FArchive& operator<<(FArchive& Ar, FAdvRecordedMove& Move)
+{
+	Ar << Move.TimeStamp;
+	Ar << Move.DeltaTime;
+	Ar << Move.Acceleration;
+
+	// Same precision as the rotation sent with ServerMove
+	uint16 Pitch = FRotator3f::CompressAxisToShort(Move.ControlRotation.Pitch);
+	uint16 Yaw = FRotator3f::CompressAxisToShort(Move.ControlRotation.Yaw);
+	uint16 Roll = FRotator3f::CompressAxisToShort(Move.ControlRotation.Roll);
+	Ar << Pitch << Yaw << Roll;
+	Move.ControlRotation = FRotator3f(FRotator3f::DecompressAxisFromShort(Pitch), FRotator3f::DecompressAxisFromShort(Yaw), FRotator3f::DecompressAxisFromShort(Roll));
+
+	Ar << Move.CompressedFlags;
+	Ar.SerializeIntPacked(Move.AdvFlags);
+
+	Ar << Move.EndLocation;
+	Ar << Move.EndVelocity;
+	Ar << Move.EndMovementMode;
+	return Ar;
+}
+
+bool FAdvMoveRecording::Save(const FString& Filename) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Ar << FileMagic << FileVersion;
+
+	FAdvMoveRecording& Mutable = const_cast<FAdvMoveRecording&>(*this);
+	Ar << Mutable.MapName << Mutable.CharacterClass;
+	Ar << Mutable.StartLocation << Mutable.StartRotation << Mutable.StartVelocity << Mutable.StartMovementMode;
+	Ar << Mutable.Moves;
+
+	return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FAdvMoveRecording::Load(const FString& Filename)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename)) return false;
+
+	FMemoryReader Ar(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Ar << FileMagic << FileVersion;
+	if (FileMagic != Magic || FileVersion != Version)
+	{
+		UE_LOG(LogAdvRecording, Error, TEXT("%s is not a move recording of version %u"), *Filename, Version);
+		return false;
+	}
+
+	Ar << MapName << CharacterClass;
+	Ar << StartLocation << StartRotation << StartVelocity << StartMovementMode;
+	Ar << Moves;
+	return !Ar.IsError();
+}
+
+FString FAdvMoveRecording::GetDefaultFilename() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("Recordings") / FString::Printf(TEXT("%s_%s.advmoves"), *FPackageName::GetShortName(MapName), *FDateTime::Now().ToString());
+}
+
+#pragma endregion Serialization
+
+#pragma region Console Commands
+
+static UAdvCharacterMovementComponent* GetLocalMovement(const UWorld* World)
+{
+	const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	const AAdvancedCharacter* Character = PC ? Cast<AAdvancedCharacter>(PC->GetPawn()) : nullptr;
+	return Character ? Character->GetAdvancedCharacterMovementComponent() : nullptr;
+}
+
+static FAutoConsoleCommandWithWorld CmdAdvRecordStart(TEXT("adv.Record.Start"), TEXT("Records every move the local player sends to the server until adv.Record.Stop"), FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	UAdvCharacterMovementComponent* Movement = GetLocalMovement(World);
+	if (!Movement || Movement->GetOwnerRole() != ROLE_AutonomousProxy)
+	{
+		UE_LOG(LogAdvRecording, Warning, TEXT("Only a client's own character sends moves that can be recorded"));
+		return;
+	}
+	Movement->StartMoveRecording();
+}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdAdvRecordStop(TEXT("adv.Record.Stop"), TEXT("Stops recording and saves the moves, Saved/Recordings/<Map>_<Time>.advmoves unless a path is given"), FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+{
+	UAdvCharacterMovementComponent* Movement = GetLocalMovement(World);
+	const TSharedPtr<FAdvMoveRecording> Recording = Movement ? Movement->StopMoveRecording() : nullptr;
+	if (!Recording.IsValid())
+	{
+		UE_LOG(LogAdvRecording, Warning, TEXT("Nothing is being recorded"));
+		return;
+	}
+
+	const FString Filename = Args.Num() > 0 ? Args[0] : Recording->GetDefaultFilename();
+	if (Recording->Save(Filename))
+	{
+		UE_LOG(LogAdvRecording, Display, TEXT("Saved %d moves to %s"), Recording->Moves.Num(), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogAdvRecording, Error, TEXT("Failed to write %s"), *Filename);
+	}
+}));
+
+#pragma endregion Console Commands
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// One move as the server receives it plus the state the client predicted at its end
+struct FAdvRecordedMove
+{
+	float TimeStamp = 0.0f;
+	float DeltaTime = 0.0f;
+	FVector3f Acceleration = FVector3f::ZeroVector;
+	FRotator3f ControlRotation = FRotator3f::ZeroRotator;
+	uint8 CompressedFlags = 0;
+	// UAdvCharacterMovementComponent::FAdvNetworkMoveData::EMoveFlags
+	uint32 AdvFlags = 0;
+
+	FVector EndLocation = FVector::ZeroVector;
+	FVector3f EndVelocity = FVector3f::ZeroVector;
+	// Packed like UCharacterMovementComponent::PackNetworkMovementMode
+	uint8 EndMovementMode = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FAdvRecordedMove& Move);
+};
+
+/// Every move a client sent to the server, in the order it sent them (resent old moves are left out)
+/// Recorded with adv.Record.Start and adv.Record.Stop [File], replayed headless by UAdvMoveReplayCommandlet
+struct FAdvMoveRecording
+{
+	static constexpr uint32 Magic = 0x41444D56;
+	static constexpr uint32 Version = 1;
+
+	// Long package name of the persistent level, PIE prefixes are stripped
+	FString MapName;
+	FString CharacterClass;
+
+	// State at the start of the first move
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+	FVector StartVelocity = FVector::ZeroVector;
+	uint8 StartMovementMode = 0;
+
+	TArray<FAdvRecordedMove> Moves;
+
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+
+	/// Saved/Recordings/<Map>_<Time>.advmoves
+	FString GetDefaultFilename() const;
+};
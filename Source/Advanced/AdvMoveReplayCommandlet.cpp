@@ -0,0 +1,200 @@
+#include "AdvMoveReplayCommandlet.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvMoveRecording.h"
+#include "AdvancedCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvReplay, Log, All);
+
+UAdvMoveReplayCommandlet::UAdvMoveReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+static FString GetModeName(const UCharacterMovementComponent* Movement, uint8 PackedMode)
+{
+	TEnumAsByte<EMovementMode> Mode;
+	TEnumAsByte<EMovementMode> GroundMode;
+	uint8 CustomMode = 0;
+	Movement->UnpackNetworkMovementMode(PackedMode, Mode, CustomMode, GroundMode);
+	if (Mode == MOVE_Custom)
+	{
+		return StaticEnum<ECustomMovementMode>()->GetNameStringByValue(CustomMode).RightChop(6);
+	}
+	return StaticEnum<EMovementMode>()->GetNameStringByValue(Mode).RightChop(5);
+}
+
+static UWorld* LoadReplayWorld(const FString& MapName)
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World) return nullptr;
+
+	World->WorldType = EWorldType::Game;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.SetTransactional(false));
+	}
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+	{
+		StreamingLevel->SetShouldBeLoaded(true);
+		StreamingLevel->SetShouldBeVisible(true);
+	}
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+	World->UpdateWorldComponents(true, false);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	return World;
+}
+
+int32 UAdvMoveReplayCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString* RecordingParam = ParamValues.Find(TEXT("Recording"));
+	if (!RecordingParam)
+	{
+		UE_LOG(LogAdvReplay, Error, TEXT("Usage: -run=AdvMoveReplay -Recording=<File>.advmoves [-Map=<Map>] [-Character=<Class Path>] [-Resync] [-Tolerance=1] [-Output=<File>.csv]"));
+		return 1;
+	}
+
+	FAdvMoveRecording Recording;
+	if (!Recording.Load(*RecordingParam))
+	{
+		UE_LOG(LogAdvReplay, Error, TEXT("Could not load recording %s"), **RecordingParam);
+		return 1;
+	}
+
+	// Overrides for recordings of maps or characters that have been renamed since
+	const FString* MapParam = ParamValues.Find(TEXT("Map"));
+	const FString MapName = MapParam ? *MapParam : Recording.MapName;
+	const FString* CharacterParam = ParamValues.Find(TEXT("Character"));
+	const FString CharacterPath = CharacterParam ? *CharacterParam : Recording.CharacterClass;
+	const bool bResync = Switches.Contains(TEXT("Resync"));
+	const FString* ToleranceParam = ParamValues.Find(TEXT("Tolerance"));
+	const float Tolerance = ToleranceParam ? FCString::Atof(**ToleranceParam) : 1.0f;
+
+	UClass* CharacterClass = LoadClass<AAdvancedCharacter>(nullptr, *CharacterPath);
+	if (!CharacterClass)
+	{
+		UE_LOG(LogAdvReplay, Error, TEXT("Could not load character class %s"), *CharacterPath);
+		return 1;
+	}
+
+	UWorld* World = LoadReplayWorld(MapName);
+	if (!World)
+	{
+		UE_LOG(LogAdvReplay, Error, TEXT("Could not load map %s"), *MapName);
+		return 1;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AAdvancedCharacter* Character = World->SpawnActor<AAdvancedCharacter>(CharacterClass, Recording.StartLocation, Recording.StartRotation, SpawnParams);
+	UAdvCharacterMovementComponent* Movement = Character ? Character->GetAdvancedCharacterMovementComponent() : nullptr;
+	if (!Movement)
+	{
+		UE_LOG(LogAdvReplay, Error, TEXT("Could not spawn %s with an advanced movement component"), *CharacterClass->GetName());
+		return 1;
+	}
+
+	// Moves only run when the replay hands them over, like on a server
+	Movement->bRunPhysicsWithNoController = true;
+	Movement->SetComponentTickEnabled(false);
+
+	World->BeginPlay();
+	Movement->ApplyNetworkMovementMode(Recording.StartMovementMode);
+	Movement->Velocity = Recording.StartVelocity;
+
+	UE_LOG(LogAdvReplay, Display, TEXT("Replaying %d moves of %s on %s"), Recording.Moves.Num(), *CharacterClass->GetName(), *MapName);
+
+	FString Csv = TEXT("Move,TimeStamp,DeltaTime,ClientMode,ServerMode,LocationError,VelocityError,Microseconds\n");
+	int32 NumDiverged = 0;
+	int32 FirstDiverged = INDEX_NONE;
+	float MaxLocationError = 0.0f;
+	double TotalMicroseconds = 0.0;
+	double MaxMicroseconds = 0.0;
+	for (int32 Index = 0; Index < Recording.Moves.Num(); Index++)
+	{
+		const FAdvRecordedMove& Move = Recording.Moves[Index];
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Movement->ReplayRecordedMove(Move);
+		const double Microseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+		const float LocationError = FVector::Dist(Movement->UpdatedComponent->GetComponentLocation(), Move.EndLocation);
+		const float VelocityError = FVector::Dist(Movement->Velocity, FVector(Move.EndVelocity));
+		const uint8 ServerMode = Movement->PackNetworkMovementMode();
+		if (LocationError > Tolerance || ServerMode != Move.EndMovementMode)
+		{
+			NumDiverged++;
+			if (FirstDiverged == INDEX_NONE) FirstDiverged = Index;
+		}
+		MaxLocationError = FMath::Max(MaxLocationError, LocationError);
+		TotalMicroseconds += Microseconds;
+		MaxMicroseconds = FMath::Max(MaxMicroseconds, Microseconds);
+
+		Csv += FString::Printf(TEXT("%d,%.4f,%.4f,%s,%s,%.3f,%.3f,%.2f\n"), Index, Move.TimeStamp, Move.DeltaTime,
+			*GetModeName(Movement, Move.EndMovementMode), *GetModeName(Movement, ServerMode), LocationError, VelocityError, Microseconds);
+
+		if (bResync)
+		{
+			Character->SetActorLocation(Move.EndLocation, false, nullptr, ETeleportType::TeleportPhysics);
+			Movement->Velocity = FVector(Move.EndVelocity);
+			if (ServerMode != Move.EndMovementMode) Movement->ApplyNetworkMovementMode(Move.EndMovementMode);
+		}
+
+		// Everything else the server would tick between the moves, animation and root motion included
+		World->Tick(LEVELTICK_All, Move.DeltaTime);
+		GFrameCounter++;
+	}
+
+	const FString* OutputParam = ParamValues.Find(TEXT("Output"));
+	const FString OutputPath = OutputParam ? *OutputParam : FPaths::ProjectSavedDir() / TEXT("Replays") / FPaths::GetBaseFilename(*RecordingParam) + TEXT(".csv");
+	const bool bSaved = FFileHelper::SaveStringToFile(Csv, *OutputPath);
+
+	const int32 NumMoves = FMath::Max(Recording.Moves.Num(), 1);
+	UE_LOG(LogAdvReplay, Display, TEXT("%d of %d moves diverged by more than %.2f (first: %d, max: %.2f)"), NumDiverged, Recording.Moves.Num(), Tolerance, FirstDiverged, MaxLocationError);
+	UE_LOG(LogAdvReplay, Display, TEXT("%.2f us per move on average, %.2f us at most"), TotalMicroseconds / NumMoves, MaxMicroseconds);
+
+	World->BeginTearingDown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (!bSaved)
+	{
+		UE_LOG(LogAdvReplay, Error, TEXT("Failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvReplay, Display, TEXT("Saved results to %s"), *OutputPath);
+
+	// A regression check can fail on divergence without parsing the csv
+	return NumDiverged > 0 ? 2 : 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AdvMoveReplayCommandlet.generated.h"
+
+/// Feeds a move recording (see FAdvMoveRecording) into an authority character on the recorded map, like a server receiving the moves
+/// UnrealEditor-Cmd Advanced.uproject -run=AdvMoveReplay -Recording=<File>.advmoves [-Map=<Map>] [-Character=<Class Path>] [-Resync] [-Tolerance=1] [-Output=<File>.csv] -unattended -nullrhi
+/// Writes one csv row per move with the divergence from what the client predicted and what the move cost
+/// The divergence accumulates over the run unless -Resync puts the character back on the client's state after every move
+/// The character is not possessed, the recorded control rotation is applied through FaceRotation like PlayerController::UpdateRotation does
+UCLASS()
+class ADVANCED_API UAdvMoveReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvMoveReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,532 @@
+#include "AdvMovementBenchmarkCommandlet.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvMovementStats.h"
+#include "AdvParallelMovementSubsystem.h"
+#include "AdvancedCharacter.h"
+#include "ClimbPointComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvBenchmark, Log, All);
+
+UAdvMovementBenchmarkCommandlet::UAdvMovementBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+#if ADV_ENABLE_MOVEMENT_STATS
+
+#pragma region Measuring
+
+// Forwards everything to the allocator it replaces and counts what the game thread allocates
+class FAdvCountingMalloc final : public FMalloc
+{
+	FMalloc* Inner;
+
+public:
+	uint64 Allocations = 0;
+
+	explicit FAdvCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		if (IsInGameThread()) Allocations++;
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		// A realloc to zero is a free
+		if (Count > 0 && IsInGameThread()) Allocations++;
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override { Inner->Free(Original); }
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+	virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual void UpdateStats() override { Inner->UpdateStats(); }
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+};
+
+struct FAdvModeStats
+{
+	uint64 CharacterTicks = 0;
+	uint64 Cycles = 0;
+	uint64 Queries = 0;
+	uint64 Allocations = 0;
+
+	void Add(const FAdvModeStats& Other)
+	{
+		CharacterTicks += Other.CharacterTicks;
+		Cycles += Other.Cycles;
+		Queries += Other.Queries;
+		Allocations += Other.Allocations;
+	}
+
+	// Per tick values are per character tick, per frame values are summed over all characters in the mode
+	TSharedRef<FJsonObject> ToJson(int32 Frames) const
+	{
+		const double Ticks = FMath::Max<double>(CharacterTicks, 1);
+		const double Milliseconds = FPlatformTime::ToMilliseconds64(Cycles);
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetNumberField(TEXT("characterTicks"), CharacterTicks);
+		Json->SetNumberField(TEXT("msPerTick"), Milliseconds / Ticks);
+		Json->SetNumberField(TEXT("msPerFrame"), Milliseconds / Frames);
+		Json->SetNumberField(TEXT("queriesPerTick"), Queries / Ticks);
+		Json->SetNumberField(TEXT("allocationsPerTick"), Allocations / Ticks);
+		return Json;
+	}
+};
+
+// Custom modes go in the low byte so the key fits both enums
+static uint16 GetModeKey(const UAdvCharacterMovementComponent* Movement)
+{
+	return static_cast<uint16>(Movement->MovementMode << 8 | (Movement->MovementMode == MOVE_Custom ? Movement->CustomMovementMode : 0));
+}
+
+static FString GetModeName(uint16 ModeKey)
+{
+	const EMovementMode Mode = static_cast<EMovementMode>(ModeKey >> 8);
+	if (Mode == MOVE_Custom)
+	{
+		return StaticEnum<ECustomMovementMode>()->GetNameStringByValue(ModeKey & 0xFF).RightChop(6);
+	}
+	return StaticEnum<EMovementMode>()->GetNameStringByValue(Mode).RightChop(5);
+}
+
+#pragma endregion Measuring
+
+#pragma region Course
+
+// Lanes are laid out in rows, everything below is lane local with +X being the running direction
+static constexpr int32 LanesPerRow = 32;
+static constexpr float LaneWidth = 600.0f;
+static constexpr float LaneLength = 6400.0f;
+static constexpr float RowGap = 1000.0f;
+// Laps that get stuck are restarted
+static constexpr float MaxLapSeconds = 30.0f;
+
+static constexpr float SlideStartX = 600.0f;
+static constexpr float SlideEndX = 1100.0f;
+static constexpr float DashX = 1400.0f;
+static constexpr float VaultBoxX = 2000.0f;
+static constexpr float MantleBoxX = 2600.0f;
+static constexpr float SwingPointX = 3550.0f;
+static constexpr float WallRunStartX = 4000.0f;
+static constexpr float WallRunEndX = 5200.0f;
+static constexpr float ClimbWallX = 5800.0f;
+// How far in front of an obstacle the jump is pressed
+static constexpr float JumpLead = 150.0f;
+
+enum class EAdvBenchmarkAction : uint8
+{
+	Slide,
+	SlideEnd,
+	Dash,
+	Vault,
+	Mantle,
+	Swing,
+	WallRun,
+	Hang,
+	Climb,
+};
+
+static void SpawnBlock(UWorld* World, UStaticMesh* Cube, const FVector& Min, const FVector& Max)
+{
+	// The engine cube is 100 units and centered on its pivot
+	const FTransform Transform(FQuat::Identity, (Min + Max) * 0.5f, (Max - Min) / 100.0f);
+	AStaticMeshActor* Block = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+	Block->GetStaticMeshComponent()->SetStaticMesh(Cube);
+	Block->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Block->FinishSpawning(Transform);
+}
+
+static void SpawnGrabPoint(UWorld* World, TSubclassOf<UClimbPointComponent> Class, const FVector& Location)
+{
+	AActor* Actor = World->SpawnActor<AActor>();
+	UClimbPointComponent* Point = NewObject<UClimbPointComponent>(Actor, Class);
+	Actor->SetRootComponent(Point);
+	// Turned around so the direction points back at the approaching character
+	Point->SetWorldLocationAndRotation(Location, FRotator(0.0f, 180.0f, 0.0f));
+	Point->RegisterComponent();
+}
+
+static FVector GetLaneOrigin(int32 Lane)
+{
+	return FVector((Lane / LanesPerRow) * (LaneLength + RowGap), (Lane % LanesPerRow) * LaneWidth, 0.0f);
+}
+
+static void BuildCourse(UWorld* World, UStaticMesh* Cube, int32 NumLanes)
+{
+	const int32 NumRows = FMath::DivideAndRoundUp(NumLanes, LanesPerRow);
+	for (int32 Row = 0; Row < NumRows; Row++)
+	{
+		const FVector RowOrigin = GetLaneOrigin(Row * LanesPerRow);
+		const int32 RowLanes = FMath::Min(NumLanes - Row * LanesPerRow, LanesPerRow);
+		SpawnBlock(World, Cube, RowOrigin + FVector(-500.0f, -LaneWidth * 0.5f, -100.0f), RowOrigin + FVector(LaneLength, LaneWidth * (RowLanes - 0.5f), 0.0f));
+	}
+
+	for (int32 Lane = 0; Lane < NumLanes; Lane++)
+	{
+		const FVector Origin = GetLaneOrigin(Lane);
+		// Thin and low enough to vault
+		SpawnBlock(World, Cube, Origin + FVector(VaultBoxX, -150.0f, 0.0f), Origin + FVector(VaultBoxX + 60.0f, 150.0f, 90.0f));
+		// Too deep to vault so it is mantled
+		SpawnBlock(World, Cube, Origin + FVector(MantleBoxX, -150.0f, 0.0f), Origin + FVector(MantleBoxX + 400.0f, 150.0f, 120.0f));
+		SpawnGrabPoint(World, USwingPointComponent::StaticClass(), Origin + FVector(SwingPointX, 0.0f, 280.0f));
+		// On the right side of the lane, the script steers into it
+		SpawnBlock(World, Cube, Origin + FVector(WallRunStartX, 130.0f, 0.0f), Origin + FVector(WallRunEndX, 180.0f, 500.0f));
+		// Too tall to mantle, hang from the point on its face then climb it
+		SpawnBlock(World, Cube, Origin + FVector(ClimbWallX, -250.0f, 0.0f), Origin + FVector(ClimbWallX + 100.0f, 250.0f, 1200.0f));
+		SpawnGrabPoint(World, UClimbPointComponent::StaticClass(), Origin + FVector(ClimbWallX - 2.0f, 0.0f, 240.0f));
+	}
+}
+
+#pragma endregion Course
+
+#pragma region Script
+
+// Drives one character through its lane, presses only last a single tick
+struct FAdvBenchmarkRunner
+{
+	AAdvancedCharacter* Character = nullptr;
+	UAdvCharacterMovementComponent* Movement = nullptr;
+	FVector Origin = FVector::ZeroVector;
+
+	// Actions already taken this lap
+	uint32 Done = 0;
+	int32 LapTicks = 0;
+	// Hang and swing need a second press once falling
+	int32 AirPressTick = INDEX_NONE;
+	int32 HoldTicks = 0;
+	int32 GroundTicks = 0;
+	bool bJumpHeld = false;
+	bool bDashHeld = false;
+
+	bool Take(EAdvBenchmarkAction Action)
+	{
+		const uint32 Bit = 1 << static_cast<uint8>(Action);
+		if (Done & Bit) return false;
+		Done |= Bit;
+		return true;
+	}
+
+	bool HasTaken(EAdvBenchmarkAction Action) const
+	{
+		return (Done & 1 << static_cast<uint8>(Action)) != 0;
+	}
+
+	void Jump()
+	{
+		Character->Jump();
+		bJumpHeld = true;
+	}
+
+	void ResetLap();
+	void Script(int32 TickRate);
+};
+
+void FAdvBenchmarkRunner::ResetLap()
+{
+	Character->StopJumping();
+	Character->StopAnimMontage();
+	Movement->CrouchReleased();
+	Movement->DashReleased();
+	Character->SetActorLocationAndRotation(Origin + FVector(0.0f, 0.0f, Character->GetDefaultHalfHeight() + 2.0f), FRotator::ZeroRotator, false, nullptr, ETeleportType::TeleportPhysics);
+	Movement->StopMovementImmediately();
+	Movement->SetMovementMode(MOVE_Falling);
+	Movement->bOrientRotationToMovement = true;
+	Movement->SprintPressed();
+
+	Done = 0;
+	LapTicks = 0;
+	AirPressTick = INDEX_NONE;
+	HoldTicks = 0;
+	GroundTicks = 0;
+	bJumpHeld = false;
+	bDashHeld = false;
+}
+
+void FAdvBenchmarkRunner::Script(int32 TickRate)
+{
+	if (bJumpHeld)
+	{
+		Character->StopJumping();
+		bJumpHeld = false;
+	}
+	if (bDashHeld)
+	{
+		Movement->DashReleased();
+		bDashHeld = false;
+	}
+
+	const FVector Local = Character->GetActorLocation() - Origin;
+	if (Local.Z < -1000.0f || ++LapTicks > TickRate * MaxLapSeconds)
+	{
+		ResetLap();
+		return;
+	}
+
+	// Let go with crouch once the mode had some time to run
+	if (Movement->IsHanging() || Movement->IsClimbing())
+	{
+		if (++HoldTicks == TickRate * (Movement->IsHanging() ? 1 : 2)) Movement->CrouchPressed();
+		Character->AddMovementInput(FVector::ForwardVector);
+		return;
+	}
+	if (HoldTicks > 0)
+	{
+		Movement->CrouchReleased();
+		HoldTicks = 0;
+	}
+
+	if (LapTicks == AirPressTick && Movement->IsFalling()) Jump();
+
+	if (Local.X >= SlideStartX && Take(EAdvBenchmarkAction::Slide)) Movement->CrouchPressed();
+	if (Local.X >= SlideEndX && Take(EAdvBenchmarkAction::SlideEnd)) Movement->CrouchReleased();
+	if (Local.X >= DashX && Take(EAdvBenchmarkAction::Dash))
+	{
+		Movement->DashPressed();
+		bDashHeld = true;
+	}
+	if (Local.X >= VaultBoxX - JumpLead && Take(EAdvBenchmarkAction::Vault)) Jump();
+	if (Local.X >= MantleBoxX - JumpLead && Take(EAdvBenchmarkAction::Mantle)) Jump();
+	if (Local.X >= SwingPointX - JumpLead * 1.5f && Take(EAdvBenchmarkAction::Swing))
+	{
+		Jump();
+		AirPressTick = LapTicks + TickRate / 4;
+	}
+	if (Local.X >= WallRunStartX && Take(EAdvBenchmarkAction::WallRun)) Jump();
+	if (Local.X >= ClimbWallX - JumpLead && Take(EAdvBenchmarkAction::Hang))
+	{
+		Jump();
+		AirPressTick = LapTicks + TickRate / 4;
+	}
+	// Back on the ground after letting go of the hang
+	if (HasTaken(EAdvBenchmarkAction::Hang) && LapTicks > AirPressTick + TickRate && Movement->IsMovingOnGround())
+	{
+		if (Take(EAdvBenchmarkAction::Climb)) Jump();
+		else if (++GroundTicks > TickRate) ResetLap();
+	}
+
+	const float Steer = Local.X > WallRunStartX - JumpLead && Local.X < WallRunEndX ? 0.5f : 0.0f;
+	Character->AddMovementInput(FVector(1.0f, Steer, 0.0f));
+}
+
+#pragma endregion Script
+
+static UWorld* CreateBenchmarkWorld()
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AdvMovementBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	return World;
+}
+
+#endif
+
+int32 UAdvMovementBenchmarkCommandlet::Main(const FString& Params)
+{
+#if ADV_ENABLE_MOVEMENT_STATS
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	auto GetInt = [&ParamValues](const TCHAR* Name, int32 Default)
+	{
+		const FString* Value = ParamValues.Find(Name);
+		return Value ? FCString::Atoi(**Value) : Default;
+	};
+	const int32 NumCharacters = FMath::Clamp(GetInt(TEXT("Characters"), 64), 1, 512);
+	const int32 NumTicks = FMath::Max(GetInt(TEXT("Ticks"), 1800), 1);
+	const int32 NumWarmupTicks = FMath::Max(GetInt(TEXT("Warmup"), 120), 0);
+	const int32 TickRate = FMath::Clamp(GetInt(TEXT("TickRate"), 60), 10, 240);
+	const float DeltaTime = 1.0f / TickRate;
+	const bool bPrefetch = Switches.Contains(TEXT("Prefetch"));
+
+	// The template character has the curves and montages the modes need
+	const FString* CharacterParam = ParamValues.Find(TEXT("Character"));
+	const FString CharacterPath = CharacterParam ? *CharacterParam : TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter.BP_ThirdPersonCharacter_C");
+	UClass* CharacterClass = LoadClass<AAdvancedCharacter>(nullptr, *CharacterPath);
+	if (!CharacterClass)
+	{
+		UE_LOG(LogAdvBenchmark, Error, TEXT("Could not load character class %s"), *CharacterPath);
+		return 1;
+	}
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!Cube)
+	{
+		UE_LOG(LogAdvBenchmark, Error, TEXT("Could not load the engine cube"));
+		return 1;
+	}
+
+	UWorld* World = CreateBenchmarkWorld();
+	BuildCourse(World, Cube, NumCharacters);
+
+	TArray<FAdvBenchmarkRunner> Runners;
+	Runners.SetNum(NumCharacters);
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 Lane = 0; Lane < NumCharacters; Lane++)
+	{
+		FAdvBenchmarkRunner& Runner = Runners[Lane];
+		Runner.Origin = GetLaneOrigin(Lane);
+		Runner.Character = World->SpawnActor<AAdvancedCharacter>(CharacterClass, Runner.Origin + FVector(0.0f, 0.0f, 200.0f), FRotator::ZeroRotator, SpawnParams);
+		Runner.Movement = Runner.Character ? Runner.Character->GetAdvancedCharacterMovementComponent() : nullptr;
+		if (!Runner.Movement)
+		{
+			UE_LOG(LogAdvBenchmark, Error, TEXT("Could not spawn %s with an advanced movement component"), *CharacterClass->GetName());
+			return 1;
+		}
+
+		// Nothing possesses the characters, the benchmark ticks the movement itself so it can be timed
+		Runner.Movement->bRunPhysicsWithNoController = true;
+		Runner.Movement->SetComponentTickEnabled(false);
+	}
+
+	World->BeginPlay();
+	for (FAdvBenchmarkRunner& Runner : Runners)
+	{
+		Runner.ResetLap();
+	}
+
+	UE_LOG(LogAdvBenchmark, Display, TEXT("Running %d characters for %d ticks at %d Hz%s"), NumCharacters, NumTicks, TickRate, bPrefetch ? TEXT(" with the parallel prefetch") : TEXT(""));
+
+	// Never freed, another thread can still be inside it after GMalloc is restored
+	FAdvCountingMalloc* CountingMalloc = new FAdvCountingMalloc(GMalloc);
+	FMalloc* PreviousMalloc = GMalloc;
+	GMalloc = CountingMalloc;
+
+	TArray<UAdvCharacterMovementComponent*> PrefetchBatch;
+	if (bPrefetch)
+	{
+		for (const FAdvBenchmarkRunner& Runner : Runners)
+		{
+			PrefetchBatch.Add(Runner.Movement);
+		}
+	}
+
+	TMap<uint16, FAdvModeStats> ModeStats;
+	FAdvModeStats PrefetchStats;
+	uint64 WorldCycles = 0;
+	for (int32 Tick = -NumWarmupTicks; Tick < NumTicks; Tick++)
+	{
+		const bool bMeasure = Tick >= 0;
+		for (FAdvBenchmarkRunner& Runner : Runners)
+		{
+			Runner.Script(TickRate);
+		}
+
+		// Ahead of every move the way the subsystem's tick function does it, so the moves find their caches filled
+		if (bPrefetch)
+		{
+			const uint64 StartQueries = FAdvMovementStats::SceneQueries;
+			const uint64 StartAllocations = CountingMalloc->Allocations;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			UAdvParallelMovementSubsystem::PrefetchMoveQueries(PrefetchBatch, DeltaTime);
+			if (bMeasure)
+			{
+				PrefetchStats.CharacterTicks += PrefetchBatch.Num();
+				PrefetchStats.Cycles += FPlatformTime::Cycles64() - StartCycles;
+				PrefetchStats.Queries += FAdvMovementStats::SceneQueries - StartQueries;
+				PrefetchStats.Allocations += CountingMalloc->Allocations - StartAllocations;
+			}
+		}
+
+		for (FAdvBenchmarkRunner& Runner : Runners)
+		{
+			const uint16 ModeKey = GetModeKey(Runner.Movement);
+			const uint64 StartQueries = FAdvMovementStats::SceneQueries;
+			const uint64 StartAllocations = CountingMalloc->Allocations;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Runner.Movement->TickComponent(DeltaTime, LEVELTICK_All, &Runner.Movement->PrimaryComponentTick);
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+			if (!bMeasure) continue;
+
+			FAdvModeStats& Stats = ModeStats.FindOrAdd(ModeKey);
+			Stats.CharacterTicks++;
+			Stats.Cycles += EndCycles - StartCycles;
+			Stats.Queries += FAdvMovementStats::SceneQueries - StartQueries;
+			Stats.Allocations += CountingMalloc->Allocations - StartAllocations;
+		}
+
+		// Everything else, animation included
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		World->Tick(LEVELTICK_All, DeltaTime);
+		if (bMeasure) WorldCycles += FPlatformTime::Cycles64() - StartCycles;
+		GFrameCounter++;
+	}
+
+	GMalloc = PreviousMalloc;
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("characterClass"), CharacterClass->GetPathName());
+	Report->SetNumberField(TEXT("characters"), NumCharacters);
+	Report->SetNumberField(TEXT("ticks"), NumTicks);
+	Report->SetNumberField(TEXT("tickRate"), TickRate);
+	Report->SetNumberField(TEXT("worldMsPerFrame"), FPlatformTime::ToMilliseconds64(WorldCycles) / NumTicks);
+
+	FAdvModeStats Total;
+	TSharedRef<FJsonObject> Modes = MakeShared<FJsonObject>();
+	for (const TPair<uint16, FAdvModeStats>& Pair : ModeStats)
+	{
+		Modes->SetObjectField(GetModeName(Pair.Key), Pair.Value.ToJson(NumTicks));
+		Total.Add(Pair.Value);
+	}
+	Report->SetObjectField(TEXT("movement"), Total.ToJson(NumTicks));
+	Report->SetObjectField(TEXT("modes"), Modes);
+	if (bPrefetch) Report->SetObjectField(TEXT("prefetch"), PrefetchStats.ToJson(NumTicks));
+
+	FString Json;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&Json));
+
+	const FString* OutputParam = ParamValues.Find(TEXT("Output"));
+	const FString OutputPath = OutputParam ? *OutputParam : FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("AdvMovement_%d%s.json"), NumCharacters, bPrefetch ? TEXT("_Prefetch") : TEXT(""));
+	const bool bSaved = FFileHelper::SaveStringToFile(Json, *OutputPath);
+	UE_LOG(LogAdvBenchmark, Display, TEXT("%s"), *Json);
+
+	World->BeginTearingDown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogAdvBenchmark, Error, TEXT("Failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvBenchmark, Display, TEXT("Saved results to %s"), *OutputPath);
+	return 0;
+#else
+	UE_LOG(LogAdvBenchmark, Error, TEXT("Movement stats are compiled out of this build"));
+	return 1;
+#endif
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AdvMovementBenchmarkCommandlet.generated.h"
+
+/// Runs N scripted characters through a generated course and reports what the movement component costs per movement mode
+/// UnrealEditor-Cmd Advanced.uproject -run=AdvMovementBenchmark [-Characters=64] [-Ticks=1800] [-Warmup=120] [-TickRate=60] [-Character=<Class Path>] [-Prefetch] [-Output=<File>.json] -unattended -nullrhi
+/// Every character gets its own lane with a slide strip, dash strip, vault box, mantle box, swing point, wall run wall and a hang point on a climb wall
+/// Movement components are ticked by the benchmark so each tick can be timed and attributed to the mode the character started it in
+/// Scene queries are the ones counted by ADV_COUNT_QUERY, allocations are game thread allocations made through GMalloc
+/// -Prefetch runs UAdvParallelMovementSubsystem's prefetch before every tick and reports it apart, the per mode queries are then the ones left to the game thread
+UCLASS()
+class ADVANCED_API UAdvMovementBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvMovementBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
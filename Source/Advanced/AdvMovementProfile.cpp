@@ -0,0 +1,29 @@
+#include "AdvMovementProfile.h"
+
+void UAdvMovementProfile::ConditionalBake()
+{
+	if (bBaked) return;
+	bBaked = true;
+
+	Slide_MinEnterSpeedSquared = FMath::Square(Slide_MinEnterSpeed);
+	Slide_MinExitSpeedSquared = FMath::Square(Slide_MinExitSpeed);
+	Slide_FrictionSamples = FAdvSampledCurve::Get(Slide_FrictionCurveFactor);
+	Mantle_CosMinWallSteepnessAngle = FMath::Cos(FMath::DegreesToRadians(Mantle_MinWallSteepnessAngle));
+	Mantle_CosMaxSurfaceAngle = FMath::Cos(FMath::DegreesToRadians(Mantle_MaxSurfaceAngle));
+	Mantle_CosMaxAlignmentAngle = FMath::Cos(FMath::DegreesToRadians(Mantle_MaxAlignmentAngle));
+	WallRun_MinSpeedSquared = FMath::Square(WallRun_MinSpeed);
+	WallRun_SinPullAwayAngle = FMath::Sin(FMath::DegreesToRadians(WallRun_PullAwayAngle));
+	WallRun_GravityScaleSamples = FAdvSampledCurve::Get(WallRun_GravityScaleCurve);
+	Probe_FrontDepth = FMath::Max(Mantle_MaxDistance, Climb_ReachDistance);
+}
+
+#if WITH_EDITOR
+void UAdvMovementProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Characters already using the profile pick the edit up on their next move
+	bBaked = false;
+	ConditionalBake();
+}
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdvSampledCurve.h"
+#include "Engine/DataAsset.h"
+#include "AdvMovementProfile.generated.h"
+
+class UCurveFloat;
+
+/// Traversal tuning of a character archetype, shared by reference between every character using it
+/// Values derived from the tuning (cosines, squared speeds, curve samples) are baked once by ConditionalBake instead of every move
+/// A component without a profile uses the defaults below (see UAdvCharacterMovementComponent::SetMovementProfile to swap at runtime)
+UCLASS()
+class ADVANCED_API UAdvMovementProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+	bool bBaked = false;
+
+public:
+	UPROPERTY(EditDefaultsOnly) float Slide_MaxSpeed = 750.0f;
+	UPROPERTY(EditDefaultsOnly) float Slide_MinEnterSpeed = 600.0f;
+	UPROPERTY(EditDefaultsOnly) float Slide_MinExitSpeed = 200.0f;
+	UPROPERTY(EditDefaultsOnly) float Slide_EnterImpulse = 400.0f;
+	UPROPERTY(EditDefaultsOnly) float Slide_GravityForce = 4000.0f;
+	// A missing curve leaves the friction unscaled
+	UPROPERTY(EditDefaultsOnly) UCurveFloat* Slide_FrictionCurveFactor;
+	UPROPERTY(EditDefaultsOnly) float Slide_MaxBrakingDeceleration = 1000.0f;
+
+	UPROPERTY(EditDefaultsOnly) float Mantle_MaxDistance = 200;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinDepth = 30;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinWallSteepnessAngle = 75;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MaxSurfaceAngle = 40;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MaxAlignmentAngle = 45;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinTransitionTime = 0.1;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MaxTransitionTime = 0.25;
+
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinShortVaultHeight = 60.f;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinTallVaultHeight = 110.f;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MaxVaultHeight = 150.f;
+
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinShortClimbHeight = 60.f;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MinTallClimbHeight = 180.f;
+	UPROPERTY(EditDefaultsOnly) float Mantle_MaxClimbHeight = 230.f;
+
+	UPROPERTY(EditDefaultsOnly) float WallRun_MinSpeed = 200.f;
+	UPROPERTY(EditDefaultsOnly) float WallRun_MaxSpeed = 800.f;
+	UPROPERTY(EditDefaultsOnly) float WallRun_MaxVerticalSpeed = 200.f;
+	UPROPERTY(EditDefaultsOnly) float WallRun_PullAwayAngle = 75;
+	UPROPERTY(EditDefaultsOnly) float WallRun_AttractionForce = 200.f;
+	UPROPERTY(EditDefaultsOnly) float WallRun_MinHeight = 50.f;
+	// A missing curve leaves gravity unscaled
+	UPROPERTY(EditDefaultsOnly) UCurveFloat* WallRun_GravityScaleCurve;
+	UPROPERTY(EditDefaultsOnly) float WallRun_JumpOffForce = 300.f;
+	// How long the wall being run on is trusted before it is traced again
+	UPROPERTY(EditDefaultsOnly) float WallRun_ContactCacheDuration = 0.2f;
+	// How far from the traced point the wall plane is trusted, the wall is traced again at the end of every move
+	UPROPERTY(EditDefaultsOnly) float WallRun_ContactCacheExtent = 300.f;
+
+	UPROPERTY(EditDefaultsOnly) float Hang_MinTransitionTime = 0.1;
+	UPROPERTY(EditDefaultsOnly) float Hang_MaxTransitionTime = 0.25;
+	UPROPERTY(EditDefaultsOnly) float Hang_WallJumpForce = 400.f;
+
+	UPROPERTY(EditDefaultsOnly) float Climb_MaxSpeed = 300.f;
+	UPROPERTY(EditDefaultsOnly) float Climb_BrakingDeceleration = 1000.f;
+	UPROPERTY(EditDefaultsOnly) float Climb_ReachDistance = 50.f;
+	UPROPERTY(EditDefaultsOnly) float Climb_MaxDuration = 3.f;
+	UPROPERTY(EditDefaultsOnly) float Climb_MantleCheckInterval = 0.5f;
+	UPROPERTY(EditDefaultsOnly) float Climb_GravityScaleCurve = 0.4f;
+	UPROPERTY(EditDefaultsOnly) float Climb_MaxDownwardVelocity = -300.f;
+
+	// Derived, only valid after ConditionalBake
+	float Slide_MinEnterSpeedSquared = 0.0f;
+	float Slide_MinExitSpeedSquared = 0.0f;
+	TSharedPtr<const FAdvSampledCurve> Slide_FrictionSamples;
+	float Mantle_CosMinWallSteepnessAngle = 0.0f;
+	float Mantle_CosMaxSurfaceAngle = 0.0f;
+	float Mantle_CosMaxAlignmentAngle = 0.0f;
+	float WallRun_MinSpeedSquared = 0.0f;
+	float WallRun_SinPullAwayAngle = 0.0f;
+	TSharedPtr<const FAdvSampledCurve> WallRun_GravityScaleSamples;
+	// Deepest any front trace of TryMantle or TryClimb reaches
+	float Probe_FrontDepth = 0.0f;
+
+	/// Bakes the derived values unless they already are, game thread only since the curves are sampled
+	void ConditionalBake();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+#include <atomic>
+
+/// stat AdvMovement, cycle stats are declared next to the functions they time
+DECLARE_STATS_GROUP(TEXT("AdvMovement"), STATGROUP_AdvMovement, STATCAT_Advanced);
+
+/// Times the enclosing scope under STAT_Adv<Name> and marks it as Adv<Name> in Insights
+#define ADV_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Adv##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Adv##Name);
+
+/// Counters for profiling the movement code, Shipping compiles them out
+#define ADV_ENABLE_MOVEMENT_STATS !UE_BUILD_SHIPPING
+
+#if ADV_ENABLE_MOVEMENT_STATS
+
+/// Read by UAdvMovementBenchmarkCommandlet, atomic since UAdvParallelMovementSubsystem queries from worker threads
+struct FAdvMovementStats
+{
+	// Scene queries issued by the advanced movement code, the engine's own floor and move sweeps are not included
+	static inline std::atomic<uint64> SceneQueries = 0;
+};
+
+/// Put in front of every scene query the movement code issues, async requests count when they are made
+/// Type is LineTrace, Overlap or Sweep and each Type/Caller pair needs a STAT_Adv<Type>_<Caller> dword counter
+#define ADV_COUNT_QUERY(Type, Caller) \
+	++FAdvMovementStats::SceneQueries; \
+	INC_DWORD_STAT(STAT_Adv##Type##_##Caller);
+
+#else
+
+#define ADV_COUNT_QUERY(Type, Caller)
+
+#endif
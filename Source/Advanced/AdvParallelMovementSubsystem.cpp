@@ -0,0 +1,112 @@
+#include "AdvParallelMovementSubsystem.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvMovementStats.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+static TAutoConsoleVariable<bool> CVarAdvParallelPrefetch(TEXT("adv.Movement.ParallelPrefetch"), true, TEXT("Runs the scene queries of AI characters with Setting_ParallelPrefetch ahead of their moves in a parallel batch"));
+static TAutoConsoleVariable<int32> CVarAdvParallelPrefetchMinBatch(TEXT("adv.Movement.ParallelPrefetchMinBatch"), 8, TEXT("Fewest characters the prefetch spreads over worker threads, smaller batches run on the game thread"));
+
+DECLARE_CYCLE_STAT(TEXT("Parallel Prefetch"), STAT_AdvParallelPrefetch, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Prefetched Characters"), STAT_AdvPrefetchedCharacters, STATGROUP_AdvMovement);
+
+void FAdvMovementPrefetchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem) Subsystem->PrefetchMoveQueries(DeltaTime);
+}
+
+FString FAdvMovementPrefetchTickFunction::DiagnosticMessage()
+{
+	return TEXT("UAdvParallelMovementSubsystem::PrefetchMoveQueries");
+}
+
+FName FAdvMovementPrefetchTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return TEXT("AdvParallelMovementSubsystem");
+}
+
+void UAdvParallelMovementSubsystem::RegisterMovement(UAdvCharacterMovementComponent* Movement)
+{
+	// Registered with the first movement since the persistent level may not exist yet when the subsystem is created
+	if (!PrefetchTickFunction.IsTickFunctionRegistered())
+	{
+		PrefetchTickFunction.Subsystem = this;
+		PrefetchTickFunction.TickGroup = TG_PrePhysics;
+		PrefetchTickFunction.bCanEverTick = true;
+		PrefetchTickFunction.bStartWithTickEnabled = true;
+		// ExecuteTick must be on the game thread, it is the one waiting on the batch so nothing moves in the scene meanwhile
+		PrefetchTickFunction.bRunOnAnyThread = false;
+		PrefetchTickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	Movements.AddUnique(Movement);
+	Movement->PrimaryComponentTick.AddPrerequisite(this, PrefetchTickFunction);
+}
+
+void UAdvParallelMovementSubsystem::UnregisterMovement(UAdvCharacterMovementComponent* Movement)
+{
+	Movements.Remove(Movement);
+	Movement->PrimaryComponentTick.RemovePrerequisite(this, PrefetchTickFunction);
+}
+
+bool UAdvParallelMovementSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAdvParallelMovementSubsystem::Deinitialize()
+{
+	if (PrefetchTickFunction.IsTickFunctionRegistered())
+	{
+		PrefetchTickFunction.UnRegisterTickFunction();
+	}
+	Movements.Reset();
+	Batch.Reset();
+
+	Super::Deinitialize();
+}
+
+void UAdvParallelMovementSubsystem::PrefetchMoveQueries(float DeltaSeconds)
+{
+	ADV_SCOPE_CYCLE_COUNTER(ParallelPrefetch)
+
+	if (!CVarAdvParallelPrefetch.GetValueOnGameThread()) return;
+
+	Batch.Reset();
+	for (int32 Index = Movements.Num() - 1; Index >= 0; Index--)
+	{
+		UAdvCharacterMovementComponent* Movement = Movements[Index].Get();
+		if (!Movement)
+		{
+			Movements.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const ACharacter* Character = Movement->GetCharacterOwner();
+		if (!Character || Character->IsPlayerControlled() || !Movement->UpdatedComponent || !Movement->IsComponentTickEnabled()) continue;
+		Batch.Add(Movement);
+	}
+	SET_DWORD_STAT(STAT_AdvPrefetchedCharacters, Batch.Num());
+	PrefetchMoveQueries(Batch, DeltaSeconds);
+}
+
+void UAdvParallelMovementSubsystem::PrefetchMoveQueries(TConstArrayView<UAdvCharacterMovementComponent*> InMovements, float DeltaSeconds)
+{
+	if (InMovements.IsEmpty()) return;
+
+	// The workers only read the ignore list, it has to be current before they start
+	for (UAdvCharacterMovementComponent* Movement : InMovements)
+	{
+		if (AAdvancedCharacter* AdvancedCharacter = Cast<AAdvancedCharacter>(Movement->GetCharacterOwner())) AdvancedCharacter->UpdateIgnoreCharacterParams();
+	}
+
+	// Each character only writes its own caches, the scene is only read
+	const EParallelForFlags Flags = InMovements.Num() < CVarAdvParallelPrefetchMinBatch.GetValueOnGameThread() ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	ParallelFor(InMovements.Num(), [InMovements, DeltaSeconds](int32 Index)
+	{
+		InMovements[Index]->PrefetchMoveQueries(DeltaSeconds);
+	}, Flags);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AdvParallelMovementSubsystem.generated.h"
+
+class UAdvCharacterMovementComponent;
+class UAdvParallelMovementSubsystem;
+
+/// Runs UAdvParallelMovementSubsystem::PrefetchMoveQueries in TG_PrePhysics, every registered movement component ticks after it
+struct FAdvMovementPrefetchTickFunction : public FTickFunction
+{
+	UAdvParallelMovementSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+/// Runs the scene queries of the server's AI characters (Setting_ParallelPrefetch) ahead of their moves, spread over the task graph
+/// Only the queries go wide: every state change, montage and delegate still happens in the character's own move on the game thread,
+/// which takes the results from its caches (see UAdvCharacterMovementComponent::PrefetchMoveQueries)
+/// Only static geometry is queried ahead, the move still queries everything else itself since it may have moved in between
+/// Player controlled characters are left out, their moves have to match what the client predicted
+/// adv.Movement.ParallelPrefetch toggles it, adv.Movement.ParallelPrefetchMinBatch sets how many characters it takes to go wide
+UCLASS()
+class ADVANCED_API UAdvParallelMovementSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	FAdvMovementPrefetchTickFunction PrefetchTickFunction;
+	TArray<TWeakObjectPtr<UAdvCharacterMovementComponent>> Movements;
+	// Reused every frame
+	TArray<UAdvCharacterMovementComponent*> Batch;
+
+public:
+	void RegisterMovement(UAdvCharacterMovementComponent* Movement);
+	void UnregisterMovement(UAdvCharacterMovementComponent* Movement);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	void PrefetchMoveQueries(float DeltaSeconds);
+	/// Prefetches the coming move of every one of InMovements, over worker threads once there are enough of them. Game thread only
+	static void PrefetchMoveQueries(TConstArrayView<UAdvCharacterMovementComponent*> InMovements, float DeltaSeconds);
+};
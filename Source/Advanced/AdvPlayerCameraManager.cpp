@@ -1,9 +1,12 @@
 #include "AdvPlayerCameraManager.h"
 
 #include "AdvCharacterMovementComponent.h"
+#include "AdvMovementStats.h"
 #include "AdvancedCharacter.h"
-#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "SignificanceManager.h"
 
+DECLARE_CYCLE_STAT(TEXT("Camera UpdateViewTarget"), STAT_AdvCameraUpdateViewTarget, STATGROUP_AdvMovement);
 
 AAdvPlayerCameraManager::AAdvPlayerCameraManager()
 {
@@ -12,6 +15,8 @@ AAdvPlayerCameraManager::AAdvPlayerCameraManager()
 
 void AAdvPlayerCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
 {
+	ADV_SCOPE_CYCLE_COUNTER(CameraUpdateViewTarget)
+
 	Super::UpdateViewTarget(OutVT, DeltaTime);
 
 	if (AAdvancedCharacter * AdvCharacter = Cast<AAdvancedCharacter>(GetOwningPlayerController()->GetPawn()))
@@ -20,8 +25,7 @@ void AAdvPlayerCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaT
 		FVector TargetCrouchOffset = FVector(
 			// x and y are irrelevant only height needed
 			0, 0,
-			// Must use a workaround to get the default object height
-			AMC->GetCrouchedHalfHeight() - AdvCharacter->GetClass()->GetDefaultObject<ACharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()
+			AdvCharacter->GetDimensions().CrouchedEyeOffset
 			);
 		
 		// Actual offset to update
@@ -47,3 +51,26 @@ void AAdvPlayerCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaT
 		}
 	}
 }
+
+void AAdvPlayerCameraManager::UpdateCamera(float DeltaTime)
+{
+	Super::UpdateCamera(DeltaTime);
+
+	// Split screen has one camera manager per player, only one of them updates
+	UWorld* World = GetWorld();
+	if (!PCOwner || !PCOwner->IsLocalController() || PCOwner != World->GetFirstPlayerController()) return;
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(World);
+	if (!SignificanceManager) return;
+
+	TArray<FTransform, TInlineAllocator<4>> Viewpoints;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController() && PC->PlayerCameraManager)
+		{
+			Viewpoints.Add(FTransform(PC->PlayerCameraManager->GetCameraRotation(), PC->PlayerCameraManager->GetCameraLocation()));
+		}
+	}
+	SignificanceManager->Update(Viewpoints);
+}
@@ -18,4 +18,6 @@ public:
 	AAdvPlayerCameraManager();
 
 	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+	/// The first local player's camera manager also updates the significance of simulated proxies from every local view
+	virtual void UpdateCamera(float DeltaTime) override;
 };
@@ -0,0 +1,53 @@
+#include "AdvSampledCurve.h"
+
+#include "Curves/CurveFloat.h"
+
+FAdvSampledCurve::FAdvSampledCurve(const UCurveFloat* Curve, float Default)
+{
+	float MaxTime = 0.0f;
+	if (Curve)
+	{
+		Curve->FloatCurve.GetTimeRange(MinTime, MaxTime);
+	}
+
+	if (!Curve || MaxTime <= MinTime)
+	{
+		const float Value = Curve ? Curve->GetFloatValue(MinTime) : Default;
+		for (float& Sample : Samples) Sample = Value;
+		return;
+	}
+
+	const float Step = (MaxTime - MinTime) / (NumSamples - 1);
+	InvStep = 1.0f / Step;
+	for (int32 Index = 0; Index < NumSamples; Index++)
+	{
+		Samples[Index] = Curve->GetFloatValue(MinTime + Index * Step);
+	}
+}
+
+TSharedRef<const FAdvSampledCurve> FAdvSampledCurve::Get(const UCurveFloat* Curve, float Default)
+{
+	check(IsInGameThread());
+
+	// Null curves are keyed by their default
+	static TMap<TPair<TObjectKey<UCurveFloat>, float>, TWeakPtr<const FAdvSampledCurve>> Bakes;
+
+	const TPair<TObjectKey<UCurveFloat>, float> Key(Curve, Curve ? 0.0f : Default);
+	if (const TWeakPtr<const FAdvSampledCurve>* Existing = Bakes.Find(Key))
+	{
+		if (TSharedPtr<const FAdvSampledCurve> Bake = Existing->Pin())
+		{
+			return Bake.ToSharedRef();
+		}
+	}
+
+	// Drop bakes nobody uses anymore, including ones of unloaded curves
+	for (auto It = Bakes.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid()) It.RemoveCurrent();
+	}
+
+	TSharedRef<const FAdvSampledCurve> Bake = MakeShareable(new FAdvSampledCurve(Curve, Default));
+	Bakes.Add(Key, Bake);
+	return Bake;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveFloat;
+
+/// A float curve baked into evenly spaced samples over its key range, evaluated without a key search
+/// Outside the key range it holds the first or last value like a curve with constant extrapolation
+/// Bakes are shared between every component using the same curve asset and are immutable once made
+struct ADVANCED_API FAdvSampledCurve
+{
+	static constexpr int32 NumSamples = 64;
+
+	/// Shared bake of Curve, a null curve bakes to Default everywhere
+	/// Game thread only, the bake lives as long as something holds on to it so PIE picks up curve edits on the next run
+	static TSharedRef<const FAdvSampledCurve> Get(const UCurveFloat* Curve, float Default = 1.0f);
+
+	FORCEINLINE float Evaluate(float Time) const
+	{
+		const float Position = FMath::Clamp((Time - MinTime) * InvStep, 0.0f, NumSamples - 1.0f);
+		const int32 Index = FMath::Min(static_cast<int32>(Position), NumSamples - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+	}
+
+private:
+	float MinTime = 0.0f;
+	// Samples per unit of time
+	float InvStep = 0.0f;
+	float Samples[NumSamples];
+
+	FAdvSampledCurve(const UCurveFloat* Curve, float Default);
+};
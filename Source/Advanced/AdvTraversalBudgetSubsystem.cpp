@@ -0,0 +1,129 @@
+#include "AdvTraversalBudgetSubsystem.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvDebugDraw.h"
+#include "AdvMovementStats.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+static TAutoConsoleVariable<float> CVarAdvTraversalProbeBudget(TEXT("adv.Traversal.ProbeBudget"), 24.0f, TEXT("Passive traversal probes the server runs per frame across all characters, 0 disables the budget"));
+static TAutoConsoleVariable<int32> CVarAdvTraversalMaxProbeInterval(TEXT("adv.Traversal.MaxProbeInterval"), 8, TEXT("Most frames the least significant character waits between passive traversal probes"));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budgeted Characters"), STAT_AdvBudgetedCharacters, STATGROUP_AdvMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Throttled Characters"), STAT_AdvThrottledCharacters, STATGROUP_AdvMovement);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Passive Probes Per Frame"), STAT_AdvPassiveProbeCost, STATGROUP_AdvMovement);
+
+void UAdvTraversalBudgetSubsystem::RegisterMovement(UAdvCharacterMovementComponent* Movement)
+{
+	FBudgetEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Movement = Movement;
+}
+
+void UAdvTraversalBudgetSubsystem::UnregisterMovement(UAdvCharacterMovementComponent* Movement)
+{
+	// Keeps the order, the ranking depends on it
+	Entries.RemoveAll([Movement](const FBudgetEntry& Entry) { return Entry.Movement == Movement; });
+}
+
+bool UAdvTraversalBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+float UAdvTraversalBudgetSubsystem::GetSignificance(FBudgetEntry& Entry, double Now) const
+{
+	const UAdvCharacterMovementComponent* Movement = Entry.Movement.Get();
+
+	float Significance = 0.0f;
+	if (!Movement->GetCurrentAcceleration().IsNearlyZero())
+	{
+		Entry.LastInputTime = Now;
+	}
+	if (Now - Entry.LastInputTime < 1.0)
+	{
+		Significance += 2.0f;
+	}
+	Significance += FMath::Min(Movement->Velocity.Size() / FMath::Max(Movement->Sprint_MaxSpeed, 1.0f), 1.5f);
+	// The async probes already found something to climb or run on, the mask is only kept with Setting_AsyncTraversalProbes
+	if (Movement->Setting_AsyncTraversalProbes && (Movement->Safe_TraversalProbeMask & UAdvCharacterMovementComponent::PROBE_Passive))
+	{
+		Significance += 2.0f;
+	}
+	return Significance;
+}
+
+void UAdvTraversalBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	if (World->GetNetMode() == NM_Client) return;
+
+	const float Budget = CVarAdvTraversalProbeBudget.GetValueOnGameThread();
+	const int32 MaxInterval = FMath::Clamp<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(CVarAdvTraversalMaxProbeInterval.GetValueOnGameThread(), 1)), 1, 128);
+	const double Now = World->GetTimeSeconds();
+
+	// Grounded characters don't probe, they keep their interval until they are airborne again
+	// Airborne players probe every move and are paid for first, the rest of the budget goes to the ranking
+	Ranking.Reset();
+	float Cost = 0.0f;
+	int32 NumPlayers = 0;
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		FBudgetEntry& Entry = Entries[Index];
+		UAdvCharacterMovementComponent* Movement = Entry.Movement.Get();
+		if (!Movement || !Movement->GetCharacterOwner() || !Movement->GetCharacterOwner()->HasAuthority()) continue;
+
+		const bool bProbing = Movement->IsFalling() || Movement->IsClimbing();
+		if (Budget <= 0.0f || Movement->GetCharacterOwner()->IsPlayerControlled())
+		{
+			Movement->SetTraversalProbeInterval(1, 0);
+			if (bProbing && Budget > 0.0f)
+			{
+				Cost += 1.0f;
+				NumPlayers++;
+			}
+			continue;
+		}
+		if (!bProbing) continue;
+
+		Entry.Significance = GetSignificance(Entry, Now);
+		Ranking.Add(Index);
+	}
+
+	// Stable so equal characters keep their registration order
+	Ranking.StableSort([this](int32 A, int32 B) { return Entries[A].Significance > Entries[B].Significance; });
+
+	// Greedy from the most significant, each character takes the shortest interval that still leaves
+	// every character after it at least the longest interval
+	int32 NumThrottled = 0;
+	for (int32 Rank = 0; Rank < Ranking.Num(); Rank++)
+	{
+		const float Reserve = static_cast<float>(Ranking.Num() - Rank - 1) / MaxInterval;
+		int32 Interval = 1;
+		while (Interval < MaxInterval && Cost + 1.0f / Interval + Reserve > Budget)
+		{
+			Interval *= 2;
+		}
+		Cost += 1.0f / Interval;
+		if (Interval > 1) NumThrottled++;
+
+		// Characters with the same interval are handed consecutive phases so they don't probe on the same frame
+		Entries[Ranking[Rank]].Movement->SetTraversalProbeInterval(Interval, Rank % Interval);
+	}
+
+	// Players can't be throttled and nobody waits longer than the longest interval, so too many characters still overrun the budget
+	if (Budget > 0.0f && Cost > Budget)
+	{
+		ADV_LOG_RATELIMITED(LogAdvMovement, Warning, 10.0, TEXT("Passive traversal probes over budget: %.1f per frame for %d players and %d characters, adv.Traversal.ProbeBudget is %.1f"), Cost, NumPlayers, Ranking.Num(), Budget)
+	}
+
+	SET_DWORD_STAT(STAT_AdvBudgetedCharacters, NumPlayers + Ranking.Num());
+	SET_DWORD_STAT(STAT_AdvThrottledCharacters, NumThrottled);
+	SET_FLOAT_STAT(STAT_AdvPassiveProbeCost, Cost);
+}
+
+TStatId UAdvTraversalBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAdvTraversalBudgetSubsystem, STATGROUP_AdvMovement);
+}
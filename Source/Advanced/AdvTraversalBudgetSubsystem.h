@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AdvTraversalBudgetSubsystem.generated.h"
+
+class UAdvCharacterMovementComponent;
+
+/// Caps the passive traversal probes (TryClimb and TryWallRun while falling) run per frame on the server
+/// Every frame the airborne characters are ranked by significance and the least significant ones are spread over more frames
+/// A character only gets the interval here, the moves it probes on are picked by its own move time (see UAdvCharacterMovementComponent::TraversalProbeInterval)
+/// Player characters are never throttled, their moves are predicted and the client has to probe on the same moves as the server,
+/// but their probes are paid for first out of the budget. Overrunning it is logged and shows in stat AdvMovement
+/// Whether the async probes found something only adds to the significance with UAdvCharacterMovementComponent::Setting_AsyncTraversalProbes
+/// Budget: adv.Traversal.ProbeBudget, 0 lets every character probe every move
+UCLASS()
+class ADVANCED_API UAdvTraversalBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FBudgetEntry
+	{
+		TWeakObjectPtr<UAdvCharacterMovementComponent> Movement;
+		double LastInputTime = -DBL_MAX;
+		float Significance = 0.0f;
+	};
+
+	// Registration order, which also breaks ties so the ranking is stable between frames
+	TArray<FBudgetEntry> Entries;
+	// Reused every frame
+	TArray<int32> Ranking;
+
+public:
+	void RegisterMovement(UAdvCharacterMovementComponent* Movement);
+	void UnregisterMovement(UAdvCharacterMovementComponent* Movement);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	float GetSignificance(FBudgetEntry& Entry, double Now) const;
+};
@@ -0,0 +1,409 @@
+#include "AdvTraversalSubsystem.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvLedgeData.h"
+#include "ClimbPointComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Level.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+const FName UAdvTraversalSubsystem::ClimbPointTag(TEXT("Climb Point"));
+const FName UAdvTraversalSubsystem::SwingPointTag(TEXT("Swing Point"));
+
+#pragma region Subsystem
+
+bool UAdvTraversalSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAdvTraversalSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UAdvTraversalSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UAdvTraversalSubsystem::OnLevelRemoved);
+}
+
+void UAdvTraversalSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+
+	GrabPoints.Empty();
+	GrabCells.Empty();
+	GrabPointIndices.Empty();
+	GrabActors.Empty();
+	for (const TPair<TObjectKey<ULevel>, TSharedPtr<FStreamableHandle>>& Load : LedgeLoads)
+	{
+		Load.Value->CancelHandle();
+	}
+	LedgeLoads.Empty();
+	LedgeData.Empty();
+	NumUnbakedLevels = 0;
+
+	Super::Deinitialize();
+}
+
+void UAdvTraversalSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (ULevel* Level : InWorld.GetLevels())
+	{
+		RegisterLevel(Level);
+	}
+
+	// Grab points spawned at runtime
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UAdvTraversalSubsystem::OnActorSpawned));
+}
+
+void UAdvTraversalSubsystem::OnLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld == GetWorld()) RegisterLevel(Level);
+}
+
+void UAdvTraversalSubsystem::OnLevelRemoved(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld == GetWorld()) UnregisterLevel(Level);
+}
+
+void UAdvTraversalSubsystem::OnActorSpawned(AActor* Actor)
+{
+	RegisterTaggedGrabPoint(Actor);
+}
+
+void UAdvTraversalSubsystem::RegisterLevel(ULevel* Level)
+{
+	if (!Level || LedgeData.Contains(Level)) return;
+
+	// Baked by UAdvLedgeBakeCommandlet and loaded in the background so streaming the level in doesn't hitch,
+	// until they arrive, and for levels never baked, all geometry is traced
+	LedgeData.Add(Level, nullptr);
+	NumUnbakedLevels++;
+	const FString PackageName = UAdvLedgeData::GetPackageNameForLevel(Level);
+	if (FPackageName::DoesPackageExist(PackageName))
+	{
+		const FSoftObjectPath Path(PackageName + TEXT(".") + FPackageName::GetShortName(PackageName));
+		TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path,
+			FStreamableDelegate::CreateUObject(this, &UAdvTraversalSubsystem::OnLedgeDataLoaded, TWeakObjectPtr<ULevel>(Level), Path));
+		// Already loaded ledges complete inside the request
+		if (Handle.IsValid() && Handle->IsLoadingInProgress()) LedgeLoads.Add(Level, Handle);
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!Actor) continue;
+
+		RegisterTaggedGrabPoint(Actor);
+
+		// Climb point components registered before the rest of their owner, so refresh the bounds now they are complete
+		TInlineComponentArray<UClimbPointComponent*> ClimbPoints(Actor);
+		for (const UClimbPointComponent* ClimbPoint : ClimbPoints)
+		{
+			if (!IsGrabPoint(ClimbPoint)) continue;
+			UnregisterGrabPoint(ClimbPoint);
+			RegisterGrabPoint(ClimbPoint);
+		}
+	}
+}
+
+void UAdvTraversalSubsystem::UnregisterLevel(ULevel* Level)
+{
+	TObjectPtr<UAdvLedgeData> Ledges;
+	if (!Level || !LedgeData.RemoveAndCopyValue(Level, Ledges)) return;
+	if (!Ledges) NumUnbakedLevels--;
+	TSharedPtr<FStreamableHandle> Load;
+	if (LedgeLoads.RemoveAndCopyValue(Level, Load)) Load->CancelHandle();
+
+	// Climb point components unregister themselves
+	for (const AActor* Actor : Level->Actors)
+	{
+		RemoveGrabPoint(Actor);
+	}
+}
+
+#pragma endregion Subsystem
+
+#pragma region Grab Points
+
+// Actors with colliding components are found by their bounds like the old overlap did
+static FBox GetGrabBounds(const AActor* Actor, const FVector& Location)
+{
+	const FBox Bounds = Actor->GetComponentsBoundingBox();
+	return Bounds.IsValid ? Bounds : FBox(Location, Location);
+}
+
+void UAdvTraversalSubsystem::RegisterGrabPoint(const UClimbPointComponent* ClimbPoint)
+{
+	const AActor* Owner = ClimbPoint->GetOwner();
+	if (!Owner || GrabPointIndices.Contains(ClimbPoint)) return;
+
+	FAdvGrabPoint Point;
+	Point.Location = ClimbPoint->GetGrabLocation();
+	Point.Direction = ClimbPoint->GetGrabDirection();
+	Point.Rotations[0] = ClimbPoint->GetGrabRotation(false);
+	Point.Rotations[1] = ClimbPoint->GetGrabRotation(true);
+	Point.Bounds = GetGrabBounds(Owner, Point.Location);
+	Point.bSwingable = ClimbPoint->IsSwingable();
+	Point.Actor = Owner;
+	Point.Source = ClimbPoint;
+	AddGrabPoint(Point);
+}
+
+void UAdvTraversalSubsystem::UnregisterGrabPoint(const UClimbPointComponent* ClimbPoint)
+{
+	RemoveGrabPoint(ClimbPoint);
+}
+
+bool UAdvTraversalSubsystem::IsGrabPoint(const UClimbPointComponent* ClimbPoint) const
+{
+	return GrabPointIndices.Contains(ClimbPoint);
+}
+
+bool UAdvTraversalSubsystem::IsGrabPoint(const AActor* Actor) const
+{
+	return GrabActors.Contains(Actor);
+}
+
+// Older grab point blueprints are only tagged and expose their facing as an FVector "Direction" variable
+// Read once here so a malformed blueprint is reported on load instead of silently failing every hang attempt
+static bool ReadGrabDirection(const AActor* Actor, FVector& OutDirection)
+{
+	const FStructProperty* StructProp = CastField<FStructProperty>(Actor->GetClass()->FindPropertyByName(TEXT("Direction")));
+	if (!StructProp || StructProp->Struct != TBaseStructure<FVector>::Get()) return false;
+
+	OutDirection = *StructProp->ContainerPtrToValuePtr<FVector>(Actor);
+	return true;
+}
+
+void UAdvTraversalSubsystem::RegisterTaggedGrabPoint(AActor* Actor)
+{
+	if (!IsValid(Actor) || GrabPointIndices.Contains(Actor)) return;
+	if (!Actor->ActorHasTag(SwingPointTag) && !Actor->ActorHasTag(ClimbPointTag)) return;
+
+	// The component already registered itself
+	if (Actor->FindComponentByClass<UClimbPointComponent>()) return;
+
+	FAdvGrabPoint Point;
+	if (!MakeTaggedGrabPoint(Actor, Point))
+	{
+		UE_LOG(LogAdvMovement, Warning, TEXT("%s is tagged as a grab point but has no UClimbPointComponent or FVector Direction variable, it can't be grabbed"), *Actor->GetPathName());
+		return;
+	}
+	AddGrabPoint(Point);
+
+	// Nothing else tells us about a tagged actor, climb point components do this themselves
+	Actor->OnDestroyed.AddUniqueDynamic(this, &UAdvTraversalSubsystem::OnTaggedGrabPointDestroyed);
+	USceneComponent* Root = Actor->GetRootComponent();
+	if (Root && Root->Mobility == EComponentMobility::Movable && !Root->TransformUpdated.IsBoundToObject(this))
+	{
+		Root->TransformUpdated.AddUObject(this, &UAdvTraversalSubsystem::OnTaggedGrabPointMoved);
+	}
+}
+
+bool UAdvTraversalSubsystem::MakeTaggedGrabPoint(const AActor* Actor, FAdvGrabPoint& OutPoint) const
+{
+	FVector Direction;
+	if (!ReadGrabDirection(Actor, Direction)) return false;
+
+	OutPoint.Location = Actor->GetActorLocation();
+	OutPoint.Direction = Direction;
+	OutPoint.Rotations[0] = FRotationMatrix::MakeFromXZ(-Direction, FVector::UpVector).ToQuat();
+	OutPoint.Rotations[1] = FRotationMatrix::MakeFromXZ(Direction, FVector::UpVector).ToQuat();
+	OutPoint.Bounds = GetGrabBounds(Actor, OutPoint.Location);
+	OutPoint.bSwingable = Actor->ActorHasTag(SwingPointTag);
+	OutPoint.Actor = Actor;
+	OutPoint.Source = Actor;
+	return true;
+}
+
+void UAdvTraversalSubsystem::OnTaggedGrabPointDestroyed(AActor* Actor)
+{
+	RemoveGrabPoint(Actor);
+}
+
+void UAdvTraversalSubsystem::OnTaggedGrabPointMoved(USceneComponent* Root, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	const AActor* Actor = Root->GetOwner();
+	if (!GrabPointIndices.Contains(Actor)) return;
+
+	// Re-bucketed like a moving climb point component
+	FAdvGrabPoint Point;
+	RemoveGrabPoint(Actor);
+	if (MakeTaggedGrabPoint(Actor, Point)) AddGrabPoint(Point);
+}
+
+void UAdvTraversalSubsystem::AddGrabPoint(const FAdvGrabPoint& Point)
+{
+	const int32 Index = GrabPoints.Add(Point);
+	GrabPointIndices.Add(Point.Source, Index);
+	GrabActors.FindOrAdd(Point.Actor)++;
+	AddToCells(Index);
+}
+
+void UAdvTraversalSubsystem::RemoveGrabPoint(const UObject* Source)
+{
+	int32 Index;
+	if (!GrabPointIndices.RemoveAndCopyValue(Source, Index)) return;
+
+	RemoveFromCells(Index);
+
+	const TObjectKey<AActor> Actor = GrabPoints[Index].Actor;
+	if (--GrabActors.FindChecked(Actor) == 0) GrabActors.Remove(Actor);
+
+	// Swap the last point into the hole and point its cells and lookup at the new index
+	const int32 LastIndex = GrabPoints.Num() - 1;
+	if (Index != LastIndex)
+	{
+		RemoveFromCells(LastIndex);
+		GrabPoints.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		AddToCells(Index);
+		GrabPointIndices.Add(GrabPoints[Index].Source, Index);
+	}
+	else
+	{
+		GrabPoints.RemoveAt(Index, 1, EAllowShrinking::No);
+	}
+}
+
+const FAdvGrabPoint* UAdvTraversalSubsystem::FindHighestGrabPoint(const FVector& Center, float Radius) const
+{
+	const FIntVector MinCell = GetCell(Center - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Center + FVector(Radius));
+	const float RadiusSquared = Radius * Radius;
+
+	const FAdvGrabPoint* Best = nullptr;
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const TArray<int32>* Cell = GrabCells.Find(FIntVector(X, Y, Z));
+				if (!Cell) continue;
+
+				for (const int32 Index : *Cell)
+				{
+					const FAdvGrabPoint& Point = GrabPoints[Index];
+					// Points spanning several cells can be visited more than once, harmless since we only keep the highest
+					if (Best && Point.Location.Z <= Best->Location.Z) continue;
+					if (!FMath::SphereAABBIntersection(Center, RadiusSquared, Point.Bounds)) continue;
+					if (!Point.Actor.ResolveObjectPtr()) continue;
+					Best = &Point;
+				}
+			}
+		}
+	}
+	return Best;
+}
+
+FIntVector UAdvTraversalSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / GrabCellSize),
+		FMath::FloorToInt(Location.Y / GrabCellSize),
+		FMath::FloorToInt(Location.Z / GrabCellSize));
+}
+
+void UAdvTraversalSubsystem::AddToCells(int32 Index)
+{
+	const FBox& Bounds = GrabPoints[Index].Bounds;
+	const FIntVector MinCell = GetCell(Bounds.Min);
+	const FIntVector MaxCell = GetCell(Bounds.Max);
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				GrabCells.FindOrAdd(FIntVector(X, Y, Z)).Add(Index);
+			}
+		}
+	}
+}
+
+void UAdvTraversalSubsystem::RemoveFromCells(int32 Index)
+{
+	const FBox& Bounds = GrabPoints[Index].Bounds;
+	const FIntVector MinCell = GetCell(Bounds.Min);
+	const FIntVector MaxCell = GetCell(Bounds.Max);
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const FIntVector Key(X, Y, Z);
+				if (TArray<int32>* Cell = GrabCells.Find(Key))
+				{
+					Cell->RemoveSingleSwap(Index, EAllowShrinking::No);
+					if (Cell->IsEmpty()) GrabCells.Remove(Key);
+				}
+			}
+		}
+	}
+}
+
+#pragma endregion Grab Points
+
+#pragma region Ledges
+
+bool UAdvTraversalSubsystem::HasLedgeData(const FAdvLedgeBakeKey& Key) const
+{
+	for (const TPair<TObjectPtr<ULevel>, TObjectPtr<UAdvLedgeData>>& Pair : LedgeData)
+	{
+		if (Pair.Value && Pair.Value->BakeKey.Matches(Key)) return true;
+	}
+	return false;
+}
+
+bool UAdvTraversalSubsystem::HasCompleteLedgeData(const FAdvLedgeBakeKey& Key) const
+{
+	if (LedgeData.IsEmpty() || NumUnbakedLevels > 0) return false;
+
+	for (const TPair<TObjectPtr<ULevel>, TObjectPtr<UAdvLedgeData>>& Pair : LedgeData)
+	{
+		if (!Pair.Value->BakeKey.Matches(Key)) return false;
+	}
+	return true;
+}
+
+const FAdvLedgeSegment* UAdvTraversalSubsystem::FindLedge(const FAdvLedgeBakeKey& Key, const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, float MinHeight, float MaxHeight, float MaxFloorHeight, FVector& OutEdgePoint) const
+{
+	const FAdvLedgeSegment* Best = nullptr;
+	float BestDistance = CheckDistance;
+	for (const TPair<TObjectPtr<ULevel>, TObjectPtr<UAdvLedgeData>>& Pair : LedgeData)
+	{
+		if (!Pair.Value || !Pair.Value->BakeKey.Matches(Key)) continue;
+
+		// Each level only searches up to the closest ledge found so far
+		FVector EdgePoint;
+		float Distance;
+		if (const FAdvLedgeSegment* Ledge = Pair.Value->FindLedge(BaseLoc, Fwd, BestDistance, MinHeight, MaxHeight, MaxFloorHeight, EdgePoint, Distance))
+		{
+			Best = Ledge;
+			BestDistance = Distance;
+			OutEdgePoint = EdgePoint;
+		}
+	}
+	return Best;
+}
+
+void UAdvTraversalSubsystem::OnLedgeDataLoaded(TWeakObjectPtr<ULevel> Level, FSoftObjectPath Path)
+{
+	LedgeLoads.Remove(Level.Get());
+
+	// The level may have streamed out while they were loading
+	TObjectPtr<UAdvLedgeData>* Ledges = Level.IsValid() ? LedgeData.Find(Level.Get()) : nullptr;
+	if (!Ledges || *Ledges) return;
+
+	*Ledges = Cast<UAdvLedgeData>(Path.ResolveObject());
+	if (*Ledges) NumUnbakedLevels--;
+}
+
+#pragma endregion Ledges
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AdvTraversalSubsystem.generated.h"
+
+class UAdvLedgeData;
+class UClimbPointComponent;
+class USceneComponent;
+struct FStreamableHandle;
+enum class EUpdateTransformFlags : int32;
+enum class ETeleportType : uint8;
+struct FAdvLedgeBakeKey;
+struct FAdvLedgeSegment;
+
+/// Everything TryHang needs to know about a climb or swing point, computed once on registration
+struct FAdvGrabPoint
+{
+	FVector Location;
+	FVector Direction;
+	// [0] faces against Direction, [1] faces along it
+	FQuat Rotations[2];
+	FBox Bounds;
+	bool bSwingable;
+	TObjectKey<AActor> Actor;
+	// The climb point component, or the actor itself for tagged blueprints
+	TObjectKey<UObject> Source;
+};
+
+/// Keeps every climb and swing point (including streamed levels) in a uniform grid
+/// so grab points can be found with a range query instead of a physics overlap and tag scan
+/// UClimbPointComponents register themselves, actors only tagged "Climb Point" / "Swing Point" are still picked up
+/// and followed until they are destroyed, movable ones are re-bucketed whenever they move
+UCLASS()
+class ADVANCED_API UAdvTraversalSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	// Grab points are small and queried with a 100 unit sphere so a query touches at most 8 cells
+	static constexpr float GrabCellSize = 200.0f;
+
+	// Dense so range queries stay cache friendly, cells only hold indices into it
+	TArray<FAdvGrabPoint> GrabPoints;
+	TMap<FIntVector, TArray<int32>> GrabCells;
+	TMap<TObjectKey<UObject>, int32> GrabPointIndices;
+	// How many grab points each actor owns
+	TMap<TObjectKey<AActor>, int32> GrabActors;
+
+	// Baked ledges of every registered level, null when the level was never baked or they are still loading
+	UPROPERTY(Transient) TMap<TObjectPtr<ULevel>, TObjectPtr<UAdvLedgeData>> LedgeData;
+	int32 NumUnbakedLevels = 0;
+	// Ledges still loading, cancelled when their level goes away first
+	TMap<TObjectKey<ULevel>, TSharedPtr<FStreamableHandle>> LedgeLoads;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle ActorSpawnedHandle;
+
+public:
+	static const FName ClimbPointTag;
+	static const FName SwingPointTag;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void RegisterGrabPoint(const UClimbPointComponent* ClimbPoint);
+	void UnregisterGrabPoint(const UClimbPointComponent* ClimbPoint);
+	bool IsGrabPoint(const UClimbPointComponent* ClimbPoint) const;
+	bool IsGrabPoint(const AActor* Actor) const;
+
+	/// Returns the highest grab point whose bounds touch the sphere, nullptr if there is none
+	const FAdvGrabPoint* FindHighestGrabPoint(const FVector& Center, float Radius) const;
+
+	/// True when any registered level has ledges baked for Key
+	bool HasLedgeData(const FAdvLedgeBakeKey& Key) const;
+	/// True when every registered level has ledges baked for Key so only non-static primitives have to be traced
+	bool HasCompleteLedgeData(const FAdvLedgeBakeKey& Key) const;
+	/// Returns the closest ledge baked for Key in front of BaseLoc across all levels, see UAdvLedgeData::FindLedge
+	const FAdvLedgeSegment* FindLedge(const FAdvLedgeBakeKey& Key, const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, float MinHeight, float MaxHeight, float MaxFloorHeight, FVector& OutEdgePoint) const;
+
+private:
+	void RegisterTaggedGrabPoint(AActor* Actor);
+	bool MakeTaggedGrabPoint(const AActor* Actor, FAdvGrabPoint& OutPoint) const;
+	UFUNCTION() void OnTaggedGrabPointDestroyed(AActor* Actor);
+	void OnTaggedGrabPointMoved(USceneComponent* Root, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	void AddGrabPoint(const FAdvGrabPoint& Point);
+	void RemoveGrabPoint(const UObject* Source);
+
+	void RegisterLevel(ULevel* Level);
+	void UnregisterLevel(ULevel* Level);
+	void OnLedgeDataLoaded(TWeakObjectPtr<ULevel> Level, FSoftObjectPath Path);
+	void OnLevelAdded(ULevel* Level, UWorld* InWorld);
+	void OnLevelRemoved(ULevel* Level, UWorld* InWorld);
+	void OnActorSpawned(AActor* Actor);
+
+	FIntVector GetCell(const FVector& Location) const;
+	void AddToCells(int32 Index);
+	void RemoveFromCells(int32 Index);
+};
@@ -1,5 +1,6 @@
 #include "AdvancedCharacter.h"
 
+#include "AdvCharacterComponents.h"
 #include "AdvCharacterMovementComponent.h"
 #include "Engine/LocalPlayer.h"
 #include "Camera/CameraComponent.h"
@@ -17,7 +18,10 @@ DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 // AAdvancedCharacter
 
 AAdvancedCharacter::AAdvancedCharacter(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer.SetDefaultSubobjectClass<UAdvCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UAdvCharacterMovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<UAdvCapsuleComponent>(ACharacter::CapsuleComponentName)
+		.SetDefaultSubobjectClass<UAdvSkeletalMeshComponent>(ACharacter::MeshComponentName))
 {
 
 	AdvancedMovementComponent = Cast<UAdvCharacterMovementComponent>(GetCharacterMovement());
@@ -59,18 +63,96 @@ AAdvancedCharacter::AAdvancedCharacter(const FObjectInitializer& ObjectInitializ
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 }
 
+void AAdvancedCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	RefreshIgnoreCharacterParams();
+	RefreshDimensions();
+}
+
 // Helper function to ignore all actors attached to a character
 // Used when performing line traces for example
-FCollisionQueryParams AAdvancedCharacter::GetIgnoreCharacterParams() const
+void AAdvancedCharacter::RefreshIgnoreCharacterParams()
 {
-	FCollisionQueryParams Params;
+	IgnoreCharacterParams = FCollisionQueryParams(SCENE_QUERY_STAT(AdvancedCharacterIgnore), false, this);
+	bIgnoreCharacterParamsDirty = false;
 
 	TArray<AActor*> CharacterChildren;
 	GetAllChildActors(CharacterChildren);
-	Params.AddIgnoredActors(CharacterChildren);
-	Params.AddIgnoredActor(this);
-	
-	return Params;
+	IgnoreCharacterParams.AddIgnoredActors(CharacterChildren);
+
+	TArray<AActor*> AttachedActors;
+	GetAttachedActors(AttachedActors, true, true);
+	IgnoreCharacterParams.AddIgnoredActors(AttachedActors);
+
+	IgnoreCharacterStaticParams = IgnoreCharacterParams;
+	IgnoreCharacterStaticParams.MobilityType = EQueryMobilityType::Static;
+	IgnoreCharacterDynamicParams = IgnoreCharacterParams;
+	IgnoreCharacterDynamicParams.MobilityType = EQueryMobilityType::Dynamic;
+}
+
+void AAdvancedCharacter::UpdateIgnoreCharacterParams()
+{
+	if (bIgnoreCharacterParamsDirty)
+	{
+		RefreshIgnoreCharacterParams();
+	}
+}
+
+void AAdvancedCharacter::RefreshDimensions()
+{
+	const UCapsuleComponent* DefaultCapsule = GetClass()->GetDefaultObject<ACharacter>()->GetCapsuleComponent();
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+
+	Dimensions.StandingRadius = DefaultCapsule->GetUnscaledCapsuleRadius();
+	Dimensions.StandingHalfHeight = DefaultCapsule->GetUnscaledCapsuleHalfHeight();
+	Dimensions.CrouchedHalfHeight = GetCharacterMovement()->GetCrouchedHalfHeight();
+	Dimensions.Scale = Capsule->GetShapeScale();
+	Dimensions.Radius = Capsule->GetScaledCapsuleRadius();
+	Dimensions.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	Dimensions.CrouchedEyeOffset = Dimensions.CrouchedHalfHeight - DefaultCapsule->GetScaledCapsuleHalfHeight();
+}
+
+void AAdvancedCharacter::SetCapsuleSize(float Radius, float HalfHeight, bool bUpdateOverlaps)
+{
+	GetCapsuleComponent()->SetCapsuleSize(Radius, HalfHeight, bUpdateOverlaps);
+	RefreshDimensions();
+}
+
+void AAdvancedCharacter::SetActorScale3D(FVector NewScale3D)
+{
+	Super::SetActorScale3D(NewScale3D);
+	RefreshDimensions();
+}
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarAdvCheckDimensions(TEXT("adv.Movement.CheckDimensions"), false, TEXT("Checks every move that the capsule wasn't resized or scaled behind the cached dimensions' back"));
+
+void AAdvancedCharacter::CheckDimensions()
+{
+	if (!CVarAdvCheckDimensions.GetValueOnGameThread()) return;
+
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+	if (!ensureMsgf(FMath::IsNearlyEqual(Dimensions.Radius, Capsule->GetScaledCapsuleRadius()) && FMath::IsNearlyEqual(Dimensions.HalfHeight, Capsule->GetScaledCapsuleHalfHeight()),
+		TEXT("%s: capsule resized or scaled without AAdvancedCharacter::SetCapsuleSize or SetActorScale3D, cached dimensions were stale"), *GetName()))
+	{
+		RefreshDimensions();
+	}
+}
+#endif
+
+// Both the engine's crouch and the slide's custom crouch resize the capsule before calling these
+void AAdvancedCharacter::OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
+{
+	RefreshDimensions();
+	Super::OnStartCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
+}
+
+void AAdvancedCharacter::OnEndCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
+{
+	RefreshDimensions();
+	Super::OnEndCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
 }
 
 void AAdvancedCharacter::Jump()
@@ -15,6 +15,22 @@ struct FInputActionValue;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
+/// Capsule sizes of the character, cached so per frame code doesn't chase the capsule component or the class defaults
+struct FAdvCharacterDimensions
+{
+	// Class defaults, unscaled
+	float StandingRadius = 0.0f;
+	float StandingHalfHeight = 0.0f;
+	float CrouchedHalfHeight = 0.0f;
+	// Shape scale of the capsule
+	float Scale = 1.0f;
+	// The capsule as it is now, scaled
+	float Radius = 0.0f;
+	float HalfHeight = 0.0f;
+	// How far the view drops while crouched
+	float CrouchedEyeOffset = 0.0f;
+};
+
 UCLASS(config=Game)
 class AAdvancedCharacter : public ACharacter
 {
@@ -48,9 +64,45 @@ class AAdvancedCharacter : public ACharacter
 protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Movement) class UAdvCharacterMovementComponent* AdvancedMovementComponent;
 
+	// Cached so traversal probes don't rebuild the ignore list every call
+	FCollisionQueryParams IgnoreCharacterParams;
+	// The same limited to static primitives, and to stationary and movable ones
+	FCollisionQueryParams IgnoreCharacterStaticParams;
+	FCollisionQueryParams IgnoreCharacterDynamicParams;
+	// Set by the capsule and mesh when another actor is attached to or detached from them
+	bool bIgnoreCharacterParamsDirty = false;
+	// Refreshed whenever the capsule changes size through crouching, SetCapsuleSize or SetActorScale3D
+	FAdvCharacterDimensions Dimensions;
+
 public:
 	AAdvancedCharacter(const FObjectInitializer& ObjectInitializer);
-	FCollisionQueryParams GetIgnoreCharacterParams() const;
+	FORCEINLINE const FCollisionQueryParams& GetIgnoreCharacterParams() const { return IgnoreCharacterParams; }
+	FORCEINLINE const FCollisionQueryParams& GetIgnoreCharacterParams(EQueryMobilityType MobilityType) const
+	{
+		return MobilityType == EQueryMobilityType::Static ? IgnoreCharacterStaticParams : MobilityType == EQueryMobilityType::Dynamic ? IgnoreCharacterDynamicParams : IgnoreCharacterParams;
+	}
+	// Rebuilds the cached ignore list
+	UFUNCTION(BlueprintCallable, Category = Movement) void RefreshIgnoreCharacterParams();
+	// Rebuilds the cached ignore list if an actor was attached or detached since it was built, game thread only
+	void UpdateIgnoreCharacterParams();
+	// Actors attached to components other than the capsule and mesh, or nested under an attached actor, have to call this themselves
+	FORCEINLINE void MarkIgnoreCharacterParamsDirty() { bIgnoreCharacterParamsDirty = true; }
+	FORCEINLINE const FAdvCharacterDimensions& GetDimensions() const { return Dimensions; }
+	// Rebuilds the cached dimensions, crouching, scaling and SetCapsuleSize already do
+	UFUNCTION(BlueprintCallable, Category = Movement) void RefreshDimensions();
+	// Resizes the capsule and the cached dimensions with it, use this over the capsule's own SetCapsuleSize
+	UFUNCTION(BlueprintCallable, Category = Movement) void SetCapsuleSize(float Radius, float HalfHeight, bool bUpdateOverlaps = true);
+	// Scales the character and the cached dimensions with it, hides AActor::SetActorScale3D. Blueprints use SetCharacterScale3D
+	void SetActorScale3D(FVector NewScale3D);
+	UFUNCTION(BlueprintCallable, Category = Movement) void SetCharacterScale3D(FVector NewScale3D) { SetActorScale3D(NewScale3D); }
+#if !UE_BUILD_SHIPPING
+	// Catches the capsule being resized or scaled behind the cache's back and refreshes it, only with adv.Movement.CheckDimensions
+	void CheckDimensions();
+#endif
+
+	virtual void PostInitializeComponents() override;
+	virtual void OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust) override;
+	virtual void OnEndCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust) override;
 
 	virtual void Jump() override;
 	virtual void StopJumping() override;
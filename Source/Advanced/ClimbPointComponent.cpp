@@ -0,0 +1,77 @@
+#include "ClimbPointComponent.h"
+
+#include "AdvCharacterMovementComponent.h"
+#include "AdvTraversalSubsystem.h"
+#include "Engine/World.h"
+
+UClimbPointComponent::UClimbPointComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	// Needed so OnUpdateTransform is called when the owner moves
+	bWantsOnUpdateTransform = true;
+}
+
+bool UClimbPointComponent::HasValidDirection() const
+{
+	return !Direction.IsNearlyZero();
+}
+
+void UClimbPointComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	UpdateGrabCache();
+
+	if (!HasValidDirection())
+	{
+		// Reported on level load rather than failing every hang attempt at runtime
+		UE_LOG(LogAdvMovement, Warning, TEXT("%s has a zero Direction and can't be grabbed"), *GetPathName());
+		return;
+	}
+
+	if (UAdvTraversalSubsystem* Traversal = GetWorld() ? GetWorld()->GetSubsystem<UAdvTraversalSubsystem>() : nullptr)
+	{
+		Traversal->RegisterGrabPoint(this);
+	}
+}
+
+void UClimbPointComponent::OnUnregister()
+{
+	if (UAdvTraversalSubsystem* Traversal = GetWorld() ? GetWorld()->GetSubsystem<UAdvTraversalSubsystem>() : nullptr)
+	{
+		Traversal->UnregisterGrabPoint(this);
+	}
+
+	Super::OnUnregister();
+}
+
+void UClimbPointComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	UpdateGrabCache();
+
+	// Moving points have to be re-bucketed in the grid
+	if (UAdvTraversalSubsystem* Traversal = GetWorld() ? GetWorld()->GetSubsystem<UAdvTraversalSubsystem>() : nullptr)
+	{
+		if (Traversal->IsGrabPoint(this))
+		{
+			Traversal->UnregisterGrabPoint(this);
+			Traversal->RegisterGrabPoint(this);
+		}
+	}
+}
+
+void UClimbPointComponent::UpdateGrabCache()
+{
+	const FTransform& Transform = GetComponentTransform();
+	GrabLocation = Transform.TransformPosition(HangOffset);
+	GrabDirection = Transform.TransformVectorNoScale(Direction).GetSafeNormal();
+	GrabRotations[0] = FRotationMatrix::MakeFromXZ(-GrabDirection, FVector::UpVector).ToQuat();
+	GrabRotations[1] = FRotationMatrix::MakeFromXZ(GrabDirection, FVector::UpVector).ToQuat();
+}
+
+USwingPointComponent::USwingPointComponent()
+{
+	bSwingable = true;
+}
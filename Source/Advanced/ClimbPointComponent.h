@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "ClimbPointComponent.generated.h"
+
+/// Marks its owner as something the character can hang from
+/// Registers itself with UAdvTraversalSubsystem and keeps its world space grab data cached until the owner moves
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class ADVANCED_API UClimbPointComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+protected:
+	// Component space direction pointing out of the wall, the character hangs facing against it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Point") FVector Direction = FVector::ForwardVector;
+	// Component space offset from the component origin to where the hands grab
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Point") FVector HangOffset = FVector::ZeroVector;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Point") bool bSwingable = false;
+
+	// Cached in world space
+	FVector GrabLocation;
+	FVector GrabDirection;
+	// [0] faces against Direction, [1] faces along it (approached from behind)
+	FQuat GrabRotations[2];
+
+public:
+	UClimbPointComponent();
+
+	FORCEINLINE const FVector& GetGrabLocation() const { return GrabLocation; }
+	FORCEINLINE const FVector& GetGrabDirection() const { return GrabDirection; }
+	FORCEINLINE const FQuat& GetGrabRotation(bool bFromBehind) const { return GrabRotations[bFromBehind ? 1 : 0]; }
+	FORCEINLINE bool IsSwingable() const { return bSwingable; }
+
+	/// False when the component was set up with a zero direction
+	bool HasValidDirection() const;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+
+private:
+	void UpdateGrabCache();
+};
+
+/// Same as a climb point but transitions into the swing montage
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class ADVANCED_API USwingPointComponent : public UClimbPointComponent
+{
+	GENERATED_BODY()
+
+public:
+	USwingPointComponent();
+};